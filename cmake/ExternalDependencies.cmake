@@ -115,6 +115,26 @@ if(BUILD_MQT_CORE_TESTS)
     EXCLUDE_FROM_ALL)
 endif()
 
+if(BUILD_MQT_CORE_BENCHMARKS)
+  # Google Benchmark is used for the microbenchmarks of the DD package. A system installation is
+  # preferred and the sources are only fetched if none is found.
+  set(BENCHMARK_ENABLE_TESTING
+      OFF
+      CACHE INTERNAL "")
+  set(BENCHMARK_ENABLE_INSTALL
+      OFF
+      CACHE INTERNAL "")
+  find_package(benchmark 1.7 QUIET)
+  if(NOT benchmark_FOUND)
+    FetchContent_Declare(
+      benchmark
+      GIT_REPOSITORY https://github.com/google/benchmark.git
+      GIT_TAG v1.7.1
+      GIT_SHALLOW TRUE)
+    list(APPEND FETCH_PACKAGES benchmark)
+  endif()
+endif()
+
 if(BINDINGS)
   if(NOT SKBUILD)
     # Manually detect the installed pybind11 package and import it into CMake.
@@ -7,12 +7,23 @@
 #include "algorithms/RandomCliffordCircuit.hpp"
 #include "algorithms/WState.hpp"
 #include "dd/Benchmark.hpp"
+#include "dd/Export.hpp"
 #include "dd/FunctionalityConstruction.hpp"
+#include "dd/Operations.hpp"
+#include "dd/Simulation.hpp"
 #include "dd/statistics/PackageStatistics.hpp"
 #include "nlohmann/json.hpp"
 
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <sstream>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 namespace dd {
 
@@ -21,6 +32,505 @@ static const std::string FILENAME_END = ".json";
 
 static constexpr std::size_t SEED = 42U;
 
+/// Package configuration using open-addressing unique tables
+struct OpenAddressingDDPackageConfig : public DDPackageConfig {
+  static constexpr bool UT_OPEN_ADDRESSING = true;
+};
+
+/**
+ * @brief Measure the performance of the unique tables of a package
+ * @details Constructs the functionality of the given circuit and afterwards
+ * measures (1) the latency of successful unique table lookups by looking up a
+ * copy of every node of the resulting DD and (2) the throughput of a forced
+ * garbage collection that collects all nodes.
+ * @tparam Config The configuration of the package to benchmark.
+ * @param qc The circuit to construct the functionality of.
+ * @returns A JSON object with the results.
+ */
+template <class Config>
+nlohmann::json benchmarkUniqueTable(const qc::QuantumComputation& qc) {
+  static constexpr std::size_t LOOKUP_REPETITIONS = 10U;
+  using Clock = std::chrono::high_resolution_clock;
+  using Seconds = std::chrono::duration<double>;
+
+  const auto nqubits = qc.getNqubits();
+  auto dd = std::make_unique<Package<Config>>(nqubits);
+
+  const auto constructionStart = Clock::now();
+  auto func = dd->makeIdent(nqubits);
+  dd->incRef(func);
+  for (const auto& op : qc) {
+    auto tmp = dd->multiply(getDD(op.get(), *dd), func);
+    dd->incRef(tmp);
+    dd->decRef(func);
+    func = tmp;
+    dd->garbageCollect();
+  }
+  const auto constructionEnd = Clock::now();
+
+  // collect all nodes of the resulting DD
+  std::vector<mNode*> nodes{};
+  std::unordered_set<mNode*> visited{};
+  std::vector<mNode*> stack{func.p};
+  while (!stack.empty()) {
+    auto* p = stack.back();
+    stack.pop_back();
+    if (mNode::isTerminal(p) || !visited.insert(p).second) {
+      continue;
+    }
+    nodes.emplace_back(p);
+    for (const auto& e : p->e) {
+      stack.emplace_back(e.p);
+    }
+  }
+
+  const auto lookupStart = Clock::now();
+  for (std::size_t r = 0U; r < LOOKUP_REPETITIONS; ++r) {
+    for (const auto* p : nodes) {
+      auto* copy = dd->mMemoryManager.get();
+      copy->v = p->v;
+      copy->e = p->e;
+      copy->flags = p->flags;
+      copy->ref = 0U;
+      dd->mUniqueTable.lookup(copy);
+    }
+  }
+  const auto lookupEnd = Clock::now();
+
+  dd->decRef(func);
+  dd->clearComputeTables();
+  const auto gcStart = Clock::now();
+  const auto collected = dd->mUniqueTable.garbageCollect(true);
+  const auto gcEnd = Clock::now();
+
+  const auto numLookups = nodes.size() * LOOKUP_REPETITIONS;
+  const auto lookupTime = Seconds(lookupEnd - lookupStart).count();
+  const auto gcTime = Seconds(gcEnd - gcStart).count();
+
+  nlohmann::json j;
+  j["construction_runtime"] =
+      Seconds(constructionEnd - constructionStart).count();
+  j["num_nodes"] = nodes.size();
+  j["lookup_latency_ns"] =
+      numLookups == 0U
+          ? 0.
+          : lookupTime * 1e9 / static_cast<double>(numLookups);
+  j["gc_runtime"] = gcTime;
+  j["gc_collected"] = collected;
+  j["gc_throughput"] =
+      gcTime == 0. ? 0. : static_cast<double>(collected) / gcTime;
+  j["unique_table"] = dd->mUniqueTable.getStatsJson();
+  return j;
+}
+
+/**
+ * @brief Compare the matrix-free gate application to matrix-vector products
+ * @details Simulates the given circuit twice starting from the all-zero
+ * state: once by multiplying with the DD of each operation and once via
+ * applyUnitaryOperation, which applies single-target gates without
+ * constructing their matrix DD.
+ * @param qc The circuit to simulate.
+ * @returns A JSON object with the results.
+ */
+nlohmann::json benchmarkGateApplication(const qc::QuantumComputation& qc) {
+  using Clock = std::chrono::high_resolution_clock;
+  using Seconds = std::chrono::duration<double>;
+
+  const auto nqubits = qc.getNqubits();
+  const auto run = [&qc, nqubits](const bool matrixFree) {
+    auto dd = std::make_unique<Package<>>(nqubits);
+    auto permutation = qc.initialLayout;
+    auto e = dd->makeZeroState(nqubits);
+    dd->incRef(e);
+    const auto start = Clock::now();
+    for (const auto& op : qc) {
+      if (!op->isUnitary()) {
+        continue;
+      }
+      auto tmp = matrixFree
+                     ? applyUnitaryOperation(op.get(), e, *dd, permutation)
+                     : dd->multiply(getDD(op.get(), *dd, permutation), e);
+      dd->incRef(tmp);
+      dd->decRef(e);
+      e = tmp;
+      dd->garbageCollect();
+    }
+    const auto end = Clock::now();
+
+    nlohmann::json j;
+    j["runtime"] = Seconds(end - start).count();
+    j["num_nodes"] = e.size();
+    j["dd"] = getStatistics(dd.get());
+    return j;
+  };
+
+  nlohmann::json j;
+  j["matrix_vector"] = run(false);
+  j["matrix_free"] = run(true);
+  const double matrixFreeRuntime = j["matrix_free"]["runtime"];
+  const double matrixVectorRuntime = j["matrix_vector"]["runtime"];
+  j["speedup"] = matrixFreeRuntime == 0.
+                     ? 0.
+                     : matrixVectorRuntime / matrixFreeRuntime;
+  return j;
+}
+
+/**
+ * @brief Compare loading snapshots to deserializing the binary format
+ * @details Constructs the functionality of the given circuit, stores it in
+ * both formats, and measures the time required to load it into a fresh
+ * package.
+ * @param qc The circuit to construct the functionality of.
+ * @returns A JSON object with the results.
+ */
+nlohmann::json benchmarkSnapshot(const qc::QuantumComputation& qc) {
+  using Clock = std::chrono::high_resolution_clock;
+  using Seconds = std::chrono::duration<double>;
+  static const std::string SERIALIZED_FILENAME = "eval_functionality.dd";
+  static const std::string SNAPSHOT_FILENAME = "eval_functionality.ddsnap";
+
+  const auto nqubits = qc.getNqubits();
+  {
+    auto dd = std::make_unique<Package<>>(nqubits);
+    const auto func = buildFunctionality(&qc, *dd);
+    serialize(func, SERIALIZED_FILENAME, true);
+    writeSnapshot(func, SNAPSHOT_FILENAME);
+  }
+
+  const auto load = [nqubits](const auto& loader) {
+    auto dd = std::make_unique<Package<>>(nqubits);
+    const auto start = Clock::now();
+    const auto func = loader(*dd);
+    const auto end = Clock::now();
+    nlohmann::json j;
+    j["runtime"] = Seconds(end - start).count();
+    j["num_nodes"] = func.size();
+    return j;
+  };
+
+  nlohmann::json j;
+  j["deserialize"] = load([](Package<>& dd) {
+    return dd.deserialize<mNode>(SERIALIZED_FILENAME, true);
+  });
+  j["snapshot"] = load([](Package<>& dd) {
+    return dd.loadSnapshot<mNode>(SNAPSHOT_FILENAME);
+  });
+  std::remove(SERIALIZED_FILENAME.c_str());
+  std::remove(SNAPSHOT_FILENAME.c_str());
+  return j;
+}
+
+/// Recursively count the nodes of a DD (reference for benchmarkTraversal)
+template <class Node>
+std::size_t sizeRecursive(const Node* p,
+                          std::unordered_set<const Node*>& visited) {
+  if (!visited.emplace(p).second) {
+    return 0U;
+  }
+  if (Node::isTerminal(p)) {
+    return 1U;
+  }
+  std::size_t sum = 1U;
+  for (const auto& e : p->e) {
+    sum += sizeRecursive(e.p, visited);
+  }
+  return sum;
+}
+
+/// Recursively compute the squared norm of a node (reference for
+/// benchmarkTraversal)
+fp normRecursive(const vNode* p, std::unordered_map<const vNode*, fp>& norms) {
+  if (vNode::isTerminal(p)) {
+    return 1.;
+  }
+  if (const auto it = norms.find(p); it != norms.end()) {
+    return it->second;
+  }
+  fp sum = 0.;
+  for (const auto& e : p->e) {
+    sum += ComplexNumbers::mag2(e.w) * normRecursive(e.p, norms);
+  }
+  norms.emplace(p, sum);
+  return sum;
+}
+
+/// Recursively compute the probability of taking the 0-successor for every
+/// node (reference for benchmarkTraversal)
+void branchProbabilitiesRecursive(const vNode* p,
+                                  std::unordered_map<const vNode*, fp>& probs) {
+  if (vNode::isTerminal(p) || probs.count(p) > 0U) {
+    return;
+  }
+  const auto p0 = ComplexNumbers::mag2(p->e[0].w);
+  const auto p1 = ComplexNumbers::mag2(p->e[1].w);
+  probs.emplace(p, p0 / (p0 + p1));
+  for (const auto& e : p->e) {
+    branchProbabilitiesRecursive(e.p, probs);
+  }
+}
+
+/// Recursively distribute sorted random numbers along the paths of a state
+/// (reference for benchmarkTraversal, see Package::sampleAll)
+void sampleRecursive(const vNode* p,
+                     const std::vector<fp>::const_iterator first,
+                     const std::vector<fp>::const_iterator last,
+                     const fp lower, const fp width,
+                     const std::unordered_map<const vNode*, fp>& probs,
+                     std::string& outcome,
+                     std::map<std::string, std::size_t>& counts) {
+  if (first == last) {
+    return;
+  }
+  if (vNode::isTerminal(p)) {
+    counts[std::string{outcome.rbegin(), outcome.rend()}] +=
+        static_cast<std::size_t>(std::distance(first, last));
+    return;
+  }
+  const auto p0 = probs.at(p);
+  const auto split = lower + (width * p0);
+  auto mid = first;
+  if (p->e[1].w.exactlyZero()) {
+    mid = last;
+  } else if (!p->e[0].w.exactlyZero()) {
+    mid = std::lower_bound(first, last, split);
+  }
+  const auto v = static_cast<std::size_t>(p->v);
+  sampleRecursive(p->e[0].p, first, mid, lower, width * p0, probs, outcome,
+                  counts);
+  outcome[v] = '1';
+  sampleRecursive(p->e[1].p, mid, last, split, width * (1. - p0), probs,
+                  outcome, counts);
+  outcome[v] = '0';
+}
+
+/**
+ * @brief Measure the performance of traversals of deep DDs
+ * @details Simulates the given circuit and constructs its functionality.
+ * Afterwards, measures the time required to determine the size of the
+ * resulting DDs, to compute the measurement probabilities of the top qubit
+ * without assuming normalization, to sample from the state, to delete the
+ * one-successor of the top node of the state, and to serialize the
+ * functionality. The depth of the DDs equals the number of qubits. The size,
+ * the probabilities, and the sampling are additionally measured with
+ * recursive reference implementations (reported with the suffix
+ * "_recursive").
+ * @param qc The circuit to simulate.
+ * @returns A JSON object with the results.
+ */
+nlohmann::json benchmarkTraversal(const qc::QuantumComputation& qc) {
+  using Clock = std::chrono::high_resolution_clock;
+  using Seconds = std::chrono::duration<double>;
+  static constexpr std::size_t REPETITIONS = 10U;
+  static constexpr std::size_t SHOTS = 1024U;
+
+  const auto nqubits = qc.getNqubits();
+  auto dd = std::make_unique<Package<>>(nqubits);
+  const auto state = simulate(&qc, dd->makeZeroState(nqubits), *dd);
+  dd->incRef(state);
+  const auto func = buildFunctionality(&qc, *dd);
+  dd->incRef(func);
+  const auto top = static_cast<Qubit>(nqubits - 1U);
+
+  const auto measure = [](const auto& traversal) {
+    const auto start = Clock::now();
+    for (std::size_t i = 0U; i < REPETITIONS; ++i) {
+      traversal();
+    }
+    const auto end = Clock::now();
+    return Seconds(end - start).count() / static_cast<double>(REPETITIONS);
+  };
+
+  nlohmann::json j;
+  j["size"] = measure([&state, &func]() {
+    static_cast<void>(state.size());
+    static_cast<void>(func.size());
+  });
+  j["size_recursive"] = measure([&state, &func]() {
+    std::unordered_set<const vNode*> vVisited{};
+    static_cast<void>(sizeRecursive(state.p, vVisited));
+    std::unordered_set<const mNode*> mVisited{};
+    static_cast<void>(sizeRecursive(func.p, mVisited));
+  });
+  j["probabilities"] = measure([&dd, &state, top]() {
+    static_cast<void>(
+        dd->determineMeasurementProbabilities(state, top, false));
+  });
+  j["probabilities_recursive"] = measure([&state]() {
+    std::unordered_map<const vNode*, fp> norms{};
+    const auto norm = ComplexNumbers::mag2(state.w);
+    static_cast<void>(std::pair{
+        norm * ComplexNumbers::mag2(state.p->e[0].w) *
+            normRecursive(state.p->e[0].p, norms),
+        norm * ComplexNumbers::mag2(state.p->e[1].w) *
+            normRecursive(state.p->e[1].p, norms)});
+  });
+  std::mt19937_64 mt(SEED);
+  j["sample"] = measure([&dd, &state, &mt]() {
+    static_cast<void>(dd->sampleAll(state, SHOTS, mt));
+  });
+  j["sample_recursive"] = measure([&state, nqubits, &mt]() {
+    std::uniform_real_distribution<fp> dist(0., 1.);
+    std::vector<fp> randoms(SHOTS);
+    for (auto& r : randoms) {
+      r = dist(mt);
+    }
+    std::sort(randoms.begin(), randoms.end());
+    std::unordered_map<const vNode*, fp> probs{};
+    branchProbabilitiesRecursive(state.p, probs);
+    std::string outcome(nqubits, '0');
+    std::map<std::string, std::size_t> counts{};
+    sampleRecursive(state.p, randoms.cbegin(), randoms.cend(), 0., 1., probs,
+                    outcome, counts);
+  });
+  j["delete_edge"] = measure([&dd, &state, top]() {
+    static_cast<void>(dd->deleteEdge(state, top, 1U));
+  });
+  j["serialize"] = measure([&func]() {
+    std::stringstream ss{};
+    serialize(func, ss, true);
+  });
+  j["num_nodes"] = state.size();
+  return j;
+}
+
+/**
+ * @brief Compare the breadth-first to the depth-first multiplication
+ * @details Constructs the functionality of the given circuit and the state
+ * resulting from its simulation. Afterwards, measures the time required to
+ * square the functionality and to apply it to the state via multiply and via
+ * multiplyByLevel. The compute tables are cleared before each product.
+ * @param qc The circuit to construct the functionality of.
+ * @returns A JSON object with the results.
+ */
+nlohmann::json benchmarkMultiplyByLevel(const qc::QuantumComputation& qc) {
+  using Clock = std::chrono::high_resolution_clock;
+  using Seconds = std::chrono::duration<double>;
+
+  const auto nqubits = qc.getNqubits();
+  auto dd = std::make_unique<Package<>>(nqubits);
+  const auto func = buildFunctionality(&qc, *dd);
+  dd->incRef(func);
+  const auto state = simulate(&qc, dd->makeZeroState(nqubits), *dd);
+  dd->incRef(state);
+
+  const auto measure = [&dd](const auto& product) {
+    dd->clearComputeTables();
+    const auto start = Clock::now();
+    const auto result = product();
+    const auto end = Clock::now();
+    nlohmann::json j;
+    j["runtime"] = Seconds(end - start).count();
+    j["num_nodes"] = result.size();
+    return j;
+  };
+
+  nlohmann::json j;
+  j["depth_first"]["matrix_matrix"] =
+      measure([&]() { return dd->multiply(func, func); });
+  j["depth_first"]["matrix_vector"] =
+      measure([&]() { return dd->multiply(func, state); });
+  j["by_level"]["matrix_matrix"] =
+      measure([&]() { return dd->multiplyByLevel(func, func); });
+  j["by_level"]["matrix_vector"] =
+      measure([&]() { return dd->multiplyByLevel(func, state); });
+  j["dd"] = getStatistics(dd.get());
+  return j;
+}
+
+/**
+ * @brief Measure the effect of compacting the memory of a package
+ * @details Simulates the given circuit and constructs its functionality, which
+ * leaves the memory managers fragmented by the garbage collections in between.
+ * Afterwards, measures the time required to compact the memory as well as the
+ * time required to apply the functionality to the state before and after the
+ * compaction. The compute tables are cleared before each product.
+ * @param qc The circuit to simulate and construct the functionality of.
+ * @returns A JSON object with the results.
+ */
+nlohmann::json benchmarkCompaction(const qc::QuantumComputation& qc) {
+  using Clock = std::chrono::high_resolution_clock;
+  using Seconds = std::chrono::duration<double>;
+  static constexpr auto MIB = static_cast<double>(1ULL << 20U);
+
+  const auto nqubits = qc.getNqubits();
+  auto dd = std::make_unique<Package<>>(nqubits);
+  auto state = simulate(&qc, dd->makeZeroState(nqubits), *dd);
+  dd->incRef(state);
+  auto func = buildFunctionality(&qc, *dd);
+  dd->incRef(func);
+
+  const auto multiply = [&]() {
+    dd->clearComputeTables();
+    const auto start = Clock::now();
+    static_cast<void>(dd->multiply(func, state));
+    const auto end = Clock::now();
+    return Seconds(end - start).count();
+  };
+  const auto fragmentation = [&dd]() {
+    nlohmann::json j;
+    j["vector"] = dd->vMemoryManager.getStats().getFragmentation();
+    j["matrix"] = dd->mMemoryManager.getStats().getFragmentation();
+    j["real_numbers"] = dd->cMemoryManager.getStats().getFragmentation();
+    return j;
+  };
+
+  nlohmann::json j;
+  j["before"]["multiply"] = multiply();
+  j["before"]["fragmentation"] = fragmentation();
+  j["before"]["memory_MiB"] = static_cast<double>(dd->getMemoryUsage()) / MIB;
+  const auto start = Clock::now();
+  const auto reclaimed = dd->compactMemory(state, func);
+  const auto end = Clock::now();
+  j["compaction"]["runtime"] = Seconds(end - start).count();
+  j["compaction"]["reclaimed_MiB"] = static_cast<double>(reclaimed) / MIB;
+  j["after"]["multiply"] = multiply();
+  j["after"]["fragmentation"] = fragmentation();
+  j["after"]["memory_MiB"] = static_cast<double>(dd->getMemoryUsage()) / MIB;
+  j["dd"] = getStatistics(dd.get());
+  return j;
+}
+
+/**
+ * @brief Compare the approximate to the exact simulation of a circuit
+ * @details Simulates the given circuit exactly and approximately with the
+ * given final fidelity and measures the runtime, the size of the final state,
+ * and the fidelity of the approximation.
+ * @param qc The circuit to simulate.
+ * @param finalFidelity The minimum fidelity of the approximated final state.
+ * @returns A JSON object with the results.
+ */
+nlohmann::json benchmarkApproximation(const qc::QuantumComputation& qc,
+                                      const fp finalFidelity) {
+  using Clock = std::chrono::high_resolution_clock;
+  using Seconds = std::chrono::duration<double>;
+  static constexpr std::size_t NODE_THRESHOLD = 256U;
+  static constexpr fp STEP_FIDELITY = 0.99;
+
+  const auto nqubits = qc.getNqubits();
+  nlohmann::json j;
+  {
+    auto dd = std::make_unique<Package<>>(nqubits);
+    const auto start = Clock::now();
+    const auto state = simulate(&qc, dd->makeZeroState(nqubits), *dd);
+    const auto end = Clock::now();
+    j["exact"]["runtime"] = Seconds(end - start).count();
+    j["exact"]["num_nodes"] = state.size();
+  }
+  {
+    auto dd = std::make_unique<Package<>>(nqubits);
+    const ApproximationParameters params{NODE_THRESHOLD, STEP_FIDELITY,
+                                         finalFidelity};
+    const auto start = Clock::now();
+    const auto result = simulate(&qc, dd->makeZeroState(nqubits), *dd, params);
+    const auto end = Clock::now();
+    j["approximate"]["runtime"] = Seconds(end - start).count();
+    j["approximate"]["num_nodes"] = result.state.size();
+    j["approximate"]["fidelity"] = result.fidelity;
+    j["approximate"]["num_approximations"] = result.numApproximations;
+  }
+  return j;
+}
+
 class BenchmarkDDPackage {
 protected:
   void verifyAndSave(const std::string& name, const std::string& type,
@@ -224,6 +734,126 @@ protected:
     }
   }
 
+  void compareUniqueTables(const std::string& name,
+                           const qc::QuantumComputation& qc) {
+    nlohmann::json results;
+    results["chained"] = benchmarkUniqueTable<DDPackageConfig>(qc);
+    results["open_addressing"] =
+        benchmarkUniqueTable<OpenAddressingDDPackageConfig>(qc);
+    saveResults(name, "UniqueTable", qc, results);
+  }
+
+  void saveResults(const std::string& name, const std::string& type,
+                   const qc::QuantumComputation& qc,
+                   const nlohmann::json& results) {
+    const std::string& filename = FILENAME_START + inputFilename + FILENAME_END;
+
+    nlohmann::json j = nlohmann::json::object();
+    if (std::ifstream ifs(filename); ifs.is_open() && ifs.peek() != EOF) {
+      ifs >> j;
+    }
+    j[name][type][std::to_string(qc.getNqubits())] = results;
+
+    std::ofstream ofs(filename);
+    ofs << j.dump(2U);
+  }
+
+  void runUniqueTable() {
+    std::cout << "Running UniqueTable comparison..." << '\n';
+    const std::array nqubitsQFT = {10U, 11U, 12U, 13U, 14U};
+    for (const auto& nq : nqubitsQFT) {
+      compareUniqueTables("QFT", qc::QFT(nq, false));
+    }
+    const std::array<std::size_t, 5> nqubitsClifford = {7U, 8U, 9U, 10U, 11U};
+    for (const auto& nq : nqubitsClifford) {
+      compareUniqueTables("RandomClifford",
+                          qc::RandomCliffordCircuit(nq, nq * nq, SEED));
+    }
+  }
+
+  void runGateApplication() {
+    std::cout << "Running GateApplication comparison..." << '\n';
+    const std::array nqubits = {256U, 512U, 1024U, 2048U, 4096U};
+    for (const auto& nq : nqubits) {
+      const auto qc = qc::Entanglement(nq);
+      saveResults("GHZ", "GateApplication", qc, benchmarkGateApplication(qc));
+    }
+    const std::array nqubitsQFT = {64U, 128U, 256U, 512U};
+    for (const auto& nq : nqubitsQFT) {
+      const auto qc = qc::QFT(nq, false);
+      saveResults("QFT", "GateApplication", qc, benchmarkGateApplication(qc));
+    }
+    const std::array<std::size_t, 5> nqubitsClifford = {14U, 15U, 16U, 17U,
+                                                        18U};
+    for (const auto& nq : nqubitsClifford) {
+      const auto qc = qc::RandomCliffordCircuit(nq, nq * nq, SEED);
+      saveResults("RandomClifford", "GateApplication", qc,
+                  benchmarkGateApplication(qc));
+    }
+  }
+
+  void runSnapshot() {
+    std::cout << "Running Snapshot comparison..." << '\n';
+    const std::array nqubitsQFT = {14U, 15U, 16U, 17U, 18U};
+    for (const auto& nq : nqubitsQFT) {
+      const auto qc = qc::QFT(nq, false);
+      saveResults("QFT", "Snapshot", qc, benchmarkSnapshot(qc));
+    }
+  }
+
+  void runTraversal() {
+    std::cout << "Running Traversal benchmark..." << '\n';
+    const std::array nqubits = {256U, 512U, 1024U, 2048U, 4096U};
+    for (const auto& nq : nqubits) {
+      const auto qc = qc::Entanglement(nq);
+      saveResults("GHZ", "Traversal", qc, benchmarkTraversal(qc));
+    }
+    for (const auto& nq : nqubits) {
+      const auto qc = qc::WState(nq);
+      saveResults("WState", "Traversal", qc, benchmarkTraversal(qc));
+    }
+  }
+
+  void runMultiplyByLevel() {
+    std::cout << "Running MultiplyByLevel comparison..." << '\n';
+    const std::array nqubitsQFT = {10U, 11U, 12U, 13U, 14U};
+    for (const auto& nq : nqubitsQFT) {
+      const auto qc = qc::QFT(nq, false);
+      saveResults("QFT", "MultiplyByLevel", qc, benchmarkMultiplyByLevel(qc));
+    }
+    const std::array<std::size_t, 5> nqubitsClifford = {7U, 8U, 9U, 10U, 11U};
+    for (const auto& nq : nqubitsClifford) {
+      const auto qc = qc::RandomCliffordCircuit(nq, nq * nq, SEED);
+      saveResults("RandomClifford", "MultiplyByLevel", qc,
+                  benchmarkMultiplyByLevel(qc));
+    }
+  }
+
+  void runCompaction() {
+    std::cout << "Running Compaction benchmark..." << '\n';
+    const std::array nqubitsQFT = {14U, 15U, 16U, 17U, 18U};
+    for (const auto& nq : nqubitsQFT) {
+      const auto qc = qc::QFT(nq, false);
+      saveResults("QFT", "Compaction", qc, benchmarkCompaction(qc));
+    }
+    const std::array<std::size_t, 5> nqubitsClifford = {7U, 8U, 9U, 10U, 11U};
+    for (const auto& nq : nqubitsClifford) {
+      const auto qc = qc::RandomCliffordCircuit(nq, nq * nq, SEED);
+      saveResults("RandomClifford", "Compaction", qc, benchmarkCompaction(qc));
+    }
+  }
+
+  void runApproximation() {
+    std::cout << "Running Approximation comparison..." << '\n';
+    static constexpr fp FINAL_FIDELITY = 0.9;
+    const std::array<std::size_t, 5> nqubits = {10U, 11U, 12U, 13U, 14U};
+    for (const auto& nq : nqubits) {
+      const auto qc = qc::RandomCliffordCircuit(nq, nq * nq, SEED);
+      saveResults("RandomClifford", "Approximation", qc,
+                  benchmarkApproximation(qc, FINAL_FIDELITY));
+    }
+  }
+
 public:
   explicit BenchmarkDDPackage(std::string filename)
       : inputFilename(std::move(filename)){};
@@ -236,6 +866,13 @@ public:
     runGrover();
     runQPE();
     runRandomClifford();
+    runUniqueTable();
+    runGateApplication();
+    runSnapshot();
+    runTraversal();
+    runMultiplyByLevel();
+    runCompaction();
+    runApproximation();
   }
 };
 
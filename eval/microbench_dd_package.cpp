@@ -0,0 +1,391 @@
+#include "QuantumComputation.hpp"
+#include "algorithms/QFT.hpp"
+#include "dd/CachedEdge.hpp"
+#include "dd/ComplexValue.hpp"
+#include "dd/ComputeTable.hpp"
+#include "dd/DDDefinitions.hpp"
+#include "dd/Export.hpp"
+#include "dd/FunctionalityConstruction.hpp"
+#include "dd/GateMatrixDefinitions.hpp"
+#include "dd/MemoryManager.hpp"
+#include "dd/Node.hpp"
+#include "dd/Package.hpp"
+#include "dd/RealNumber.hpp"
+#include "dd/Traversal.hpp"
+#include "operations/Control.hpp"
+#include "nlohmann/json.hpp"
+
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dd {
+
+static constexpr std::size_t SEED = 42U;
+
+/// A dense random state on the given number of qubits
+static vEdge makeRandomState(Package<>& dd, const std::size_t nqubits,
+                             const std::size_t seed = SEED) {
+  std::mt19937_64 mt(seed);
+  std::uniform_real_distribution<fp> dist(-1., 1.);
+  CVec vec(1ULL << nqubits);
+  fp norm = 0.;
+  for (auto& entry : vec) {
+    entry = {dist(mt), dist(mt)};
+    norm += std::norm(entry);
+  }
+  for (auto& entry : vec) {
+    entry /= std::sqrt(norm);
+  }
+  auto e = dd.makeStateFromVector(vec);
+  dd.incRef(e);
+  return e;
+}
+
+/// Collect all nodes of a DD
+template <class Node>
+static std::vector<Node*> collectNodes(const Edge<Node>& e) {
+  std::vector<Node*> nodes{};
+  VisitedSet<Node> visited{};
+  traversePostOrder(e.p, visited, [&nodes](const Node* p) {
+    nodes.emplace_back(const_cast<Node*>(p)); // NOLINT
+  });
+  return nodes;
+}
+
+/// Successful lookups of (copies of) existing nodes in the unique table
+static void uniqueTableLookup(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  auto dd = std::make_unique<Package<>>(n);
+  const auto e = makeRandomState(*dd, n);
+  const auto nodes = collectNodes(e);
+  for (auto _ : state) {
+    for (const auto* p : nodes) {
+      // a successful lookup returns the copy to the memory manager
+      auto* copy = dd->vMemoryManager.get();
+      copy->v = p->v;
+      copy->e = p->e;
+      copy->ref = 0U;
+      benchmark::DoNotOptimize(dd->vUniqueTable.lookup(copy));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(nodes.size()));
+}
+
+/// Successful lookups of existing numbers in the real number table
+static void realNumberLookup(benchmark::State& state) {
+  const auto numValues = 1ULL << static_cast<std::size_t>(state.range(0));
+  auto dd = std::make_unique<Package<>>(1U);
+  std::mt19937_64 mt(SEED);
+  std::uniform_real_distribution<fp> dist(0., 1.);
+  std::vector<fp> values(numValues);
+  for (auto& value : values) {
+    value = dist(mt);
+    static_cast<void>(RealNumber::incRef(dd->cUniqueTable.lookup(value)));
+  }
+  for (auto _ : state) {
+    for (const auto value : values) {
+      benchmark::DoNotOptimize(dd->cUniqueTable.lookup(value));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(numValues));
+}
+
+/// Inserting entries into a compute table and looking them up again
+static void computeTableInsertLookup(benchmark::State& state) {
+  const auto numEntries = 1ULL << static_cast<std::size_t>(state.range(0));
+  // the table only hashes and compares the addresses of the operands
+  std::vector<vNode> nodes(numEntries + 1U);
+  ComputeTable<vNode*, vNode*, vCachedEdge> table{};
+  for (auto _ : state) {
+    for (std::size_t i = 0U; i < numEntries; ++i) {
+      table.insert(&nodes[i], &nodes[i + 1U], {&nodes[i], 1.});
+    }
+    for (std::size_t i = 0U; i < numEntries; ++i) {
+      benchmark::DoNotOptimize(table.lookup(&nodes[i], &nodes[i + 1U]));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(2U * numEntries));
+}
+
+/// Obtaining entries from a memory manager and returning them again
+static void memoryManagerGetReturn(benchmark::State& state) {
+  const auto numEntries = 1ULL << static_cast<std::size_t>(state.range(0));
+  MemoryManager<vNode> manager{};
+  std::vector<vNode*> entries(numEntries);
+  for (auto _ : state) {
+    for (auto& entry : entries) {
+      entry = manager.get();
+    }
+    for (auto* entry : entries) {
+      manager.returnEntry(entry);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(2U * numEntries));
+}
+
+/// Constructing the DD of a controlled gate
+static void gateConstruction(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  auto dd = std::make_unique<Package<>>(n);
+  const auto target = static_cast<qc::Qubit>(n / 2U);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        dd->makeGateDD(H_MAT, n, qc::Control{0U}, target));
+  }
+}
+
+/// Multiplying a controlled gate with a dense state (without cached results)
+static void matrixVectorMultiplication(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  auto dd = std::make_unique<Package<>>(n);
+  const auto e = makeRandomState(*dd, n);
+  auto gate = dd->makeGateDD(H_MAT, n, qc::Control{0U},
+                             static_cast<qc::Qubit>(n - 1U));
+  dd->incRef(gate);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dd->multiply(gate, e));
+    state.PauseTiming();
+    dd->clearComputeTables();
+    dd->garbageCollect();
+    state.ResumeTiming();
+  }
+}
+
+/// Adding two dense states (without cached results)
+static void vectorAddition(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  auto dd = std::make_unique<Package<>>(n);
+  const auto x = makeRandomState(*dd, n);
+  const auto y = makeRandomState(*dd, n, SEED + 1U);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dd->add(x, y));
+    state.PauseTiming();
+    dd->clearComputeTables();
+    dd->garbageCollect();
+    state.ResumeTiming();
+  }
+}
+
+/// The Kronecker product of two dense states (without cached results)
+static void vectorKronecker(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  auto dd = std::make_unique<Package<>>(2U * n);
+  const auto x = makeRandomState(*dd, n);
+  const auto y = makeRandomState(*dd, n, SEED + 1U);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dd->kronecker(x, y));
+    state.PauseTiming();
+    dd->clearComputeTables();
+    dd->garbageCollect();
+    state.ResumeTiming();
+  }
+}
+
+/// Sampling all qubits of a dense state without collapsing it
+static void measurement(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  auto dd = std::make_unique<Package<>>(n);
+  auto e = makeRandomState(*dd, n);
+  std::mt19937_64 mt(SEED);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dd->measureAll(e, false, mt));
+  }
+}
+
+/// Serializing a dense state (in binary format)
+static void serialization(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  auto dd = std::make_unique<Package<>>(n);
+  const auto e = makeRandomState(*dd, n);
+  for (auto _ : state) {
+    std::stringstream ss{};
+    dd::serialize(e, ss, true);
+    benchmark::DoNotOptimize(ss);
+  }
+}
+
+/// Deserializing a dense state (in binary format)
+static void deserialization(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  auto dd = std::make_unique<Package<>>(n);
+  const auto e = makeRandomState(*dd, n);
+  std::stringstream serialized{};
+  dd::serialize(e, serialized, true);
+  const auto data = serialized.str();
+  for (auto _ : state) {
+    std::stringstream ss(data);
+    benchmark::DoNotOptimize(dd->deserialize<vNode>(ss, true));
+  }
+}
+
+/// The functionality of a QFT (0) or a random rotation circuit (1)
+static mEdge makeFunctionality(Package<>& dd, const std::int64_t circuit,
+                               const std::size_t nqubits) {
+  if (circuit == 0) {
+    const qc::QFT qft(nqubits, false);
+    return buildFunctionality(&qft, dd);
+  }
+  qc::QuantumComputation qc(nqubits);
+  std::mt19937_64 mt(SEED);
+  std::uniform_real_distribution<fp> dist(0., 2. * PI);
+  for (std::size_t layer = 0U; layer < 4U; ++layer) {
+    for (std::size_t q = 0U; q < nqubits; ++q) {
+      qc.ry(dist(mt), static_cast<qc::Qubit>(q));
+      qc.rz(dist(mt), static_cast<qc::Qubit>(q));
+    }
+    for (std::size_t q = 0U; q + 1U < nqubits; ++q) {
+      qc.cx(static_cast<qc::Qubit>(q), static_cast<qc::Qubit>(q + 1U));
+    }
+  }
+  return buildFunctionality(&qc, dd);
+}
+
+/// The edge weights of all nodes of a DD together with their maximum index
+static std::vector<std::pair<std::array<ComplexValue, NEDGE>, std::size_t>>
+collectWeights(const mEdge& e) {
+  std::vector<std::pair<std::array<ComplexValue, NEDGE>, std::size_t>>
+      weights{};
+  for (const auto* p : collectNodes(e)) {
+    auto& [w, argMax] = weights.emplace_back();
+    for (std::size_t i = 0U; i < NEDGE; ++i) {
+      w[i] = static_cast<ComplexValue>(p->e[i].w);
+      if (w[i].mag2() > w[argMax].mag2()) {
+        argMax = i;
+      }
+    }
+  }
+  return weights;
+}
+
+/// Normalizing the edge weights of all nodes weight by weight
+static void weightNormalizationScalar(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(1));
+  auto dd = std::make_unique<Package<>>(n);
+  const auto e = makeFunctionality(*dd, state.range(0), n);
+  const auto weights = collectWeights(e);
+  // as during parallel evaluation
+  dd->cUniqueTable.setConcurrent(state.range(2) != 0);
+  for (auto _ : state) {
+    for (const auto& [w, argMax] : weights) {
+      for (std::size_t i = 0U; i < NEDGE; ++i) {
+        if (i != argMax && !w[i].exactlyZero()) {
+          benchmark::DoNotOptimize(dd->cn.lookup(w[i] / w[argMax]));
+        }
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(weights.size()));
+}
+
+/// Normalizing the edge weights of all nodes with the batched kernels
+static void weightNormalizationBatched(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(1));
+  auto dd = std::make_unique<Package<>>(n);
+  const auto e = makeFunctionality(*dd, state.range(0), n);
+  const auto weights = collectWeights(e);
+  // as during parallel evaluation
+  dd->cUniqueTable.setConcurrent(state.range(2) != 0);
+  for (auto _ : state) {
+    for (const auto& [w, argMax] : weights) {
+      auto normalized = w;
+      divide(normalized.data(), NEDGE, w[argMax]);
+      normalized[argMax] = 0.;
+      benchmark::DoNotOptimize(dd->cn.lookup(normalized));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(weights.size()));
+}
+
+BENCHMARK(uniqueTableLookup)->DenseRange(8, 16, 4);
+BENCHMARK(realNumberLookup)->DenseRange(8, 16, 4);
+BENCHMARK(computeTableInsertLookup)->DenseRange(8, 16, 4);
+BENCHMARK(memoryManagerGetReturn)->DenseRange(8, 16, 4);
+BENCHMARK(gateConstruction)->DenseRange(8, 32, 8);
+BENCHMARK(matrixVectorMultiplication)->DenseRange(8, 16, 4);
+BENCHMARK(vectorAddition)->DenseRange(8, 16, 4);
+BENCHMARK(vectorKronecker)->DenseRange(4, 8, 2);
+BENCHMARK(measurement)->DenseRange(8, 16, 4);
+BENCHMARK(serialization)->DenseRange(8, 16, 4);
+BENCHMARK(deserialization)->DenseRange(8, 16, 4);
+BENCHMARK(weightNormalizationScalar)->ArgsProduct({{0, 1}, {6, 8}, {0, 1}});
+BENCHMARK(weightNormalizationBatched)->ArgsProduct({{0, 1}, {6, 8}, {0, 1}});
+
+/**
+ * @brief Reporter additionally collecting results in the format of the
+ * evaluation script
+ * @details Results are stored as `DDPrimitives.<benchmark>.<argument>` with
+ * the runtime per iteration in seconds. If benchmarks are repeated, the mean
+ * and the standard deviation over all repetitions are reported instead.
+ */
+class BaselineReporter : public benchmark::ConsoleReporter {
+public:
+  void ReportRuns(const std::vector<Run>& reports) override {
+    ConsoleReporter::ReportRuns(reports);
+    for (const auto& run : reports) {
+      if (run.iterations == 0) {
+        continue;
+      }
+      auto& entry =
+          results["DDPrimitives"][run.run_name.function_name][run.run_name.args];
+      const auto runtime =
+          run.real_accumulated_time / static_cast<double>(run.iterations);
+      if (run.run_type == Run::RT_Aggregate) {
+        if (run.aggregate_name == "mean") {
+          entry["runtime"] = runtime;
+        } else if (run.aggregate_name == "stddev") {
+          entry["runtime_stddev"] = runtime;
+        }
+      } else if (!entry.contains("runtime_stddev")) {
+        entry["runtime"] = runtime;
+        entry["iterations"] = run.iterations;
+      }
+    }
+  }
+
+  [[nodiscard]] const nlohmann::json& getResults() const { return results; }
+
+private:
+  nlohmann::json results = nlohmann::json::object();
+};
+
+} // namespace dd
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  if (argc > 2) {
+    std::cerr << "At most one argument (besides the benchmark options) is "
+                 "allowed to name the results file."
+              << '\n';
+    return 1;
+  }
+  dd::BaselineReporter reporter{};
+  benchmark::RunSpecifiedBenchmarks(&reporter);
+  benchmark::Shutdown();
+
+  if (argc == 2) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const auto filename = "results_" + std::string(argv[1]) + ".json";
+    std::ofstream ofs(filename);
+    ofs << reporter.getResults().dump(2U);
+    std::cout << "Results written to " << filename << '\n';
+  }
+  return 0;
+}
@@ -30,6 +30,20 @@ public:
 
   static void singleQubitGateFusion(QuantumComputation& qc);
 
+  /**
+   * @brief Fuses consecutive gates into blocks acting on a limited number of
+   * qubits.
+   * @details Every block is represented by a CompoundOperation. A gate is
+   * added to the blocks that currently end the circuit on its qubits as long
+   * as the resulting block acts on at most `maxBlockSize` qubits. Blocks
+   * consisting of a single gate are not wrapped. Non-unitary operations,
+   * classically-controlled operations, compound operations, and barriers are
+   * never fused.
+   * @param qc the quantum circuit
+   * @param maxBlockSize the maximum number of qubits a block may act on
+   */
+  static void collectBlocks(QuantumComputation& qc, std::size_t maxBlockSize);
+
   static void removeIdentities(QuantumComputation& qc);
 
   static void removeDiagonalGatesBeforeMeasure(QuantumComputation& qc);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "dd/Package.hpp"
+#include "dd/statistics/OperationTrace.hpp"
 #include "nlohmann/json.hpp"
 
 #include <chrono>
@@ -38,12 +39,23 @@ struct FunctionalityConstructionExperiment : public Experiment {
   }
 };
 
+/// Simulate a circuit, optionally tracing every operation (see simulate).
+/// If `fusionBlockSize` is non-zero, gates are first fused into blocks acting
+/// on at most that many qubits (see CircuitOptimizer::collectBlocks) and the
+/// fusion is reported under the `gate_fusion` key of the statistics.
 std::unique_ptr<SimulationExperiment>
-benchmarkSimulate(const qc::QuantumComputation& qc);
+benchmarkSimulate(const qc::QuantumComputation& qc,
+                  OperationTracer* tracer = nullptr,
+                  std::size_t fusionBlockSize = 0U);
 
+/// Construct the functionality of a circuit, optionally tracing every
+/// operation (only supported by the non-recursive construction, otherwise
+/// std::invalid_argument is thrown). Gates are fused as in benchmarkSimulate.
 std::unique_ptr<FunctionalityConstructionExperiment>
 benchmarkFunctionalityConstruction(const qc::QuantumComputation& qc,
-                                   bool recursive = false);
+                                   bool recursive = false,
+                                   OperationTracer* tracer = nullptr,
+                                   std::size_t fusionBlockSize = 0U);
 
 std::map<std::string, std::size_t>
 benchmarkSimulateWithShots(const qc::QuantumComputation& qc, std::size_t shots);
@@ -1,13 +1,15 @@
 #pragma once
 
 #include "dd/Complex.hpp"
+#include "dd/ComplexValue.hpp"
 #include "dd/DDDefinitions.hpp"
 #include "dd/Node.hpp"
 #include "dd/RealNumberUniqueTable.hpp"
 
-namespace dd {
+#include <array>
+#include <cstddef>
 
-struct ComplexValue;
+namespace dd {
 
 /// A class for managing complex numbers in the DD package.
 class ComplexNumbers {
@@ -97,6 +99,30 @@ public:
    */
   [[nodiscard]] Complex lookup(fp r, fp i);
 
+  /**
+   * @brief Lookup several complex values in the complex table at once.
+   * @details Yields the same numbers as looking up every value on its own.
+   * @param values The complex numbers.
+   * @return The found or added complex numbers.
+   * @see RealNumberUniqueTable::lookup(const fp*, std::size_t, RealNumber**)
+   */
+  template <std::size_t N>
+  [[nodiscard]] std::array<Complex, N>
+  lookup(const std::array<ComplexValue, N>& values) {
+    std::array<fp, 2U * N> parts{};
+    for (std::size_t k = 0U; k < N; ++k) {
+      parts[2U * k] = values[k].r;
+      parts[(2U * k) + 1U] = values[k].i;
+    }
+    std::array<RealNumber*, 2U * N> entries{};
+    uniqueTable->lookup(parts.data(), parts.size(), entries.data());
+    std::array<Complex, N> result{};
+    for (std::size_t k = 0U; k < N; ++k) {
+      result[k] = {entries[2U * k], entries[(2U * k) + 1U]};
+    }
+    return result;
+  }
+
   /**
    * @brief Turn CachedEdge into Edge via lookup.
    * @tparam Node The type of the node.
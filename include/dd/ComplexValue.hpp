@@ -137,6 +137,18 @@ ComplexValue operator*(const ComplexValue& c1, const ComplexValue& c2);
 ComplexValue operator/(const ComplexValue& c1, fp r);
 ComplexValue operator/(const ComplexValue& c1, const ComplexValue& c2);
 
+/**
+ * @brief Divide several complex values by the same divisor in place.
+ * @details Produces exactly the same results as dividing every value on its
+ * own. The denominator is only computed once and the remaining arithmetic is
+ * performed on all values in a single loop.
+ * @param values The complex values to divide.
+ * @param count The number of values.
+ * @param divisor The divisor.
+ */
+void divide(ComplexValue* values, std::size_t count,
+            const ComplexValue& divisor) noexcept;
+
 /**
  * @brief Print a complex value to the given output stream.
  * @param os The output stream to write to.
@@ -1,29 +1,45 @@
 #pragma once
 
+#include "dd/Concurrency.hpp"
 #include "dd/DDDefinitions.hpp"
 #include "dd/Node.hpp"
-#include "dd/statistics/TableStatistics.hpp"
+#include "dd/statistics/ComputeTableStatistics.hpp"
 
-#include <array>
-#include <bitset>
+#include <algorithm>
 #include <cstddef>
 #include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace dd {
 
 /// Data structure for caching computed results
+/// \details The table is set-associative: every bucket holds up to NWAYS
+/// entries, which are kept in least-recently-used order. A lookup hit moves
+/// the entry to the front of its bucket and inserting into a full bucket
+/// evicts the least-recently-used entry. With NWAYS = 1 (the default), the
+/// table is direct-mapped and every insert overwrites the bucket's entry.
+/// The number of buckets can be changed at runtime via `resize` or grown
+/// automatically based on the load factor via `growIfNeeded`.
 /// \tparam LeftOperandType type of the operation's left operand
 /// \tparam RightOperandType type of the operation's right operand
 /// \tparam ResultType type of the operation's result
-/// \tparam NBUCKET number of hash buckets to use (has to be a power of two)
+/// \tparam NBUCKET initial number of hash buckets to use (has to be a power of
+/// two)
+/// \tparam NWAYS number of entries per bucket
 template <class LeftOperandType, class RightOperandType, class ResultType,
-          std::size_t NBUCKET = 16384>
+          std::size_t NBUCKET = 16384, std::size_t NWAYS = 1>
 class ComputeTable {
+  static_assert(NWAYS > 0U, "Compute tables need at least one way");
+
 public:
   ComputeTable() {
     stats.entrySize = sizeof(Entry);
-    stats.numBuckets = NBUCKET;
+    stats.numBuckets = NBUCKET * NWAYS;
+    stats.setNumWays(NWAYS);
   }
 
   struct Entry {
@@ -34,16 +50,36 @@ public:
 
   static constexpr std::size_t MASK = NBUCKET - 1;
 
+  /**
+   * @brief The load factor from which on `growIfNeeded` grows the table.
+   */
+  static constexpr double GROWTH_LOAD_FACTOR = 0.75;
+
+  /**
+   * @brief Hash a single operand
+   * @details Node addresses are aligned, so their lowest bits carry no
+   * information. Pointers are therefore mixed before being combined, as
+   * otherwise only a fraction of the buckets would ever be used.
+   */
+  template <class T> static std::size_t hashOperand(const T& operand) {
+    if constexpr (std::is_pointer_v<T>) {
+      return qc::murmur64(reinterpret_cast<std::size_t>(operand));
+    } else {
+      return std::hash<T>{}(operand);
+    }
+  }
+
   static std::size_t hash(const LeftOperandType& leftOperand,
-                          const RightOperandType& rightOperand) {
-    auto h1 = std::hash<LeftOperandType>{}(leftOperand);
+                          const RightOperandType& rightOperand,
+                          const std::size_t numBuckets = NBUCKET) {
+    auto h1 = hashOperand(leftOperand);
     if constexpr (std::is_same_v<LeftOperandType, dNode*>) {
       if (!dNode::isTerminal(leftOperand)) {
         h1 = qc::combineHash(
             h1, dd::dNode::getDensityMatrixTempFlags(leftOperand->flags));
       }
     }
-    auto h2 = std::hash<RightOperandType>{}(rightOperand);
+    auto h2 = hashOperand(rightOperand);
     if constexpr (std::is_same_v<RightOperandType, dNode*>) {
       if (!dNode::isTerminal(rightOperand)) {
         h2 = qc::combineHash(
@@ -51,7 +87,7 @@ public:
       }
     }
     const auto hash = qc::combineHash(h1, h2);
-    return hash & MASK;
+    return hash & (numBuckets - 1);
   }
 
   /// Get a reference to the table
@@ -60,52 +96,222 @@ public:
   /// Get a reference to the statistics
   [[nodiscard]] const auto& getStats() const noexcept { return stats; }
 
+  /// Get the current number of buckets
+  [[nodiscard]] std::size_t getNumBuckets() const noexcept {
+    return numBuckets;
+  }
+
+  /**
+   * @brief Change the number of buckets of the table
+   * @details All valid entries are rehashed into the resized table. If the
+   * table shrinks, entries might be evicted. Resizing must not be performed
+   * concurrently with any other operation on the table.
+   * @param nbuckets The new number of buckets (has to be a power of two).
+   */
+  void resize(const std::size_t nbuckets) {
+    if (nbuckets == 0U || (nbuckets & (nbuckets - 1U)) != 0U) {
+      throw std::invalid_argument(
+          "Number of compute table buckets must be a power of two.");
+    }
+    auto oldTable = std::move(table);
+    auto oldValid = std::move(valid);
+    const auto oldNumBuckets = numBuckets;
+
+    numBuckets = nbuckets;
+    table.assign(numBuckets * NWAYS, Entry{});
+    valid.assign(numBuckets * NWAYS, false);
+    stats.numBuckets = numBuckets * NWAYS;
+    stats.numEntries = 0U;
+    for (std::size_t b = 0U; b < oldNumBuckets; ++b) {
+      // re-insert from the least to the most recently used entry so that the
+      // order of entries within a bucket is preserved
+      for (auto way = NWAYS; way-- > 0U;) {
+        const auto idx = (b * NWAYS) + way;
+        if (!oldValid[idx]) {
+          continue;
+        }
+        const auto& entry = oldTable[idx];
+        const auto bucket =
+            hash(entry.leftOperand, entry.rightOperand, numBuckets) * NWAYS;
+        auto w = 0U;
+        while (w < NWAYS && valid[bucket + w]) {
+          ++w;
+        }
+        if (w == NWAYS) {
+          ++stats.evictions;
+          w = NWAYS - 1U;
+        } else {
+          valid[bucket + w] = true;
+          ++stats.numEntries;
+        }
+        moveToFront(bucket, w);
+        table[bucket] = entry;
+      }
+    }
+  }
+
+  /**
+   * @brief Grow the table if its load factor is too high
+   * @details Doubles the number of buckets if the load factor of the table
+   * reached GROWTH_LOAD_FACTOR and the resulting number of buckets does not
+   * exceed the given limit.
+   * @param maxBuckets The maximum number of buckets.
+   * @returns Whether the table was grown.
+   */
+  bool growIfNeeded(const std::size_t maxBuckets) {
+    if (numBuckets * 2U > maxBuckets ||
+        stats.loadFactor() < GROWTH_LOAD_FACTOR) {
+      return false;
+    }
+    resize(numBuckets * 2U);
+    return true;
+  }
+
+  /**
+   * @brief Shrink the table back to its initial number of buckets
+   * @details Releases the memory occupied by buckets added via `resize` or
+   * `growIfNeeded`. Entries that do not fit the smaller table are evicted.
+   * @returns Whether the table was shrunk.
+   */
+  bool shrinkToInitialSize() {
+    if (numBuckets <= NBUCKET) {
+      return false;
+    }
+    resize(NBUCKET);
+    return true;
+  }
+
+  /**
+   * @brief Enable or disable concurrent access to the table.
+   * @details If enabled, `insert` and `lookup` may be called from multiple
+   * threads simultaneously. Accesses are serialized by a mutex and `lookup`
+   * returns a pointer to a thread-local copy of the cached result, which stays
+   * valid until the next lookup in a table of the same type on the same
+   * thread. Clearing the table must still not be performed concurrently.
+   * @param enable Whether to enable concurrent access.
+   */
+  void setConcurrent(const bool enable) noexcept { concurrent = enable; }
+
+  /// Check whether concurrent access is enabled
+  [[nodiscard]] bool isConcurrent() const noexcept { return concurrent; }
+
   void insert(const LeftOperandType& leftOperand,
               const RightOperandType& rightOperand, const ResultType& result) {
-    const auto key = hash(leftOperand, rightOperand);
-    if (valid[key]) {
+    const auto bucket = hash(leftOperand, rightOperand, numBuckets) * NWAYS;
+    const auto lock = conditionalLock(mutex, concurrent);
+    auto way = 0U;
+    if constexpr (NWAYS > 1U) {
+      // search for an entry with the same operands or the first free way
+      for (; way < NWAYS; ++way) {
+        if (!valid[bucket + way] ||
+            (table[bucket + way].leftOperand == leftOperand &&
+             table[bucket + way].rightOperand == rightOperand)) {
+          break;
+        }
+      }
+    }
+    if (way == NWAYS) {
+      // the bucket is full, evict the least recently used entry
       ++stats.collisions;
+      ++stats.evictions;
+      way = NWAYS - 1U;
+    } else if (valid[bucket + way]) {
+      ++stats.collisions;
+      if constexpr (NWAYS == 1U) {
+        // direct-mapped tables overwrite the entry without searching first
+        if (table[bucket].leftOperand != leftOperand ||
+            table[bucket].rightOperand != rightOperand) {
+          ++stats.evictions;
+        }
+      }
     } else {
       stats.trackInsert();
-      valid.set(key);
+      valid[bucket + way] = true;
     }
-    table[key] = {leftOperand, rightOperand, result};
+    moveToFront(bucket, way);
+    table[bucket] = {leftOperand, rightOperand, result};
   }
 
   ResultType* lookup(const LeftOperandType& leftOperand,
                      const RightOperandType& rightOperand,
                      [[maybe_unused]] const bool useDensityMatrix = false) {
     ResultType* result = nullptr;
+    const auto bucket = hash(leftOperand, rightOperand, numBuckets) * NWAYS;
+    const auto lock = conditionalLock(mutex, concurrent);
     ++stats.lookups;
-    const auto key = hash(leftOperand, rightOperand);
-    if (!valid[key]) {
-      return result;
-    }
+    for (auto way = 0U; way < NWAYS; ++way) {
+      // valid entries always form a prefix of the bucket
+      if (!valid[bucket + way]) {
+        return result;
+      }
 
-    auto& entry = table[key];
-    if (entry.leftOperand != leftOperand) {
-      return result;
-    }
-    if (entry.rightOperand != rightOperand) {
-      return result;
+      const auto& entry = table[bucket + way];
+      if (entry.leftOperand != leftOperand) {
+        continue;
+      }
+      if (entry.rightOperand != rightOperand) {
+        continue;
+      }
+
+      if constexpr (std::is_same_v<RightOperandType, dEdge>) {
+        // Since density matrices are reduced representations of matrices, a
+        // density matrix may not be returned when a matrix is required and
+        // vice versa
+        if (!dNode::isTerminal(entry.result.p) &&
+            dNode::isDensityMatrixNode(entry.result.p->flags) !=
+                useDensityMatrix) {
+          return result;
+        }
+      }
+      ++stats.hits;
+      ++stats.hitsPerWay[way];
+      moveToFront(bucket, way);
+      if (concurrent) {
+        // the entry might be overwritten by another thread as soon as the
+        // lock is released
+        thread_local ResultType copy{};
+        copy = table[bucket].result;
+        return &copy;
+      }
+      return &table[bucket].result;
     }
+    return result;
+  }
 
-    if constexpr (std::is_same_v<RightOperandType, dEdge>) {
-      // Since density matrices are reduced representations of matrices, a
-      // density matrix may not be returned when a matrix is required and vice
-      // versa
-      if (!dNode::isTerminal(entry.result.p) &&
-          dNode::isDensityMatrixNode(entry.result.p->flags) !=
-              useDensityMatrix) {
-        return result;
+  /**
+   * @brief Invalidate all entries satisfying a predicate
+   * @details Used after garbage collection to only drop the entries that refer
+   * to reclaimed nodes instead of clearing the whole table. The remaining
+   * entries of a bucket keep their least-recently-used order. Invalidation
+   * must not be performed concurrently with any other operation on the table.
+   * @param predicate The predicate deciding whether an entry is invalidated.
+   * @returns The number of invalidated entries.
+   */
+  template <class Predicate> std::size_t invalidateIf(Predicate&& predicate) {
+    std::size_t invalidated = 0U;
+    for (std::size_t bucket = 0U; bucket < table.size(); bucket += NWAYS) {
+      // compact the retained entries so that valid entries form a prefix
+      auto kept = 0U;
+      for (auto way = 0U; way < NWAYS && valid[bucket + way]; ++way) {
+        if (predicate(table[bucket + way])) {
+          valid[bucket + way] = false;
+          ++invalidated;
+          continue;
+        }
+        if (kept != way) {
+          table[bucket + kept] = table[bucket + way];
+          valid[bucket + kept] = true;
+          valid[bucket + way] = false;
+        }
+        ++kept;
       }
     }
-    ++stats.hits;
-    return &entry.result;
+    stats.trackCollection(invalidated);
+    return invalidated;
   }
 
   void clear() {
-    valid.reset();
+    std::fill(valid.begin(), valid.end(), false);
     stats.reset();
   }
 
@@ -114,8 +320,28 @@ public:
   }
 
 private:
-  std::array<Entry, NBUCKET> table{};
-  std::bitset<NBUCKET> valid{};
-  TableStatistics stats{};
+  /// The current number of buckets
+  std::size_t numBuckets = NBUCKET;
+  /// The entries of the table (NWAYS consecutive entries per bucket)
+  std::vector<Entry> table = std::vector<Entry>(NBUCKET * NWAYS);
+  /// Whether the respective entry of the table is valid
+  std::vector<bool> valid = std::vector<bool>(NBUCKET * NWAYS, false);
+  ComputeTableStatistics stats{};
+
+  /// Move the entry in the given way of a bucket to the front of the bucket
+  void moveToFront(const std::size_t bucket, const std::size_t way) {
+    if constexpr (NWAYS > 1U) {
+      if (way > 0U) {
+        const auto first = table.begin() + static_cast<std::ptrdiff_t>(bucket);
+        const auto last = first + static_cast<std::ptrdiff_t>(way);
+        std::rotate(first, last, last + 1);
+      }
+    }
+  }
+
+  /// Whether concurrent access to the table is enabled
+  bool concurrent = false;
+  /// The mutex guarding the table if concurrent access is enabled
+  std::mutex mutex;
 };
 } // namespace dd
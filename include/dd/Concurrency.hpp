@@ -0,0 +1,27 @@
+#pragma once
+
+#include <mutex>
+
+namespace dd {
+
+/**
+ * @brief Acquire a lock on a mutex only if concurrent access is enabled.
+ * @details The data structures of the DD package (memory managers and unique
+ * tables) are single-threaded by default. When concurrent access is enabled,
+ * their mutating operations are guarded by a mutex. This helper returns a lock
+ * that owns the mutex if and only if @p enabled is set. Otherwise, the returned
+ * lock is deferred and no synchronization overhead besides a single branch is
+ * incurred.
+ * @param mutex The mutex to lock.
+ * @param enabled Whether concurrent access is enabled.
+ * @returns A (possibly unlocked) lock on the mutex.
+ */
+[[nodiscard]] inline std::unique_lock<std::mutex>
+conditionalLock(std::mutex& mutex, const bool enabled) {
+  if (enabled) {
+    return std::unique_lock{mutex};
+  }
+  return std::unique_lock{mutex, std::defer_lock};
+}
+
+} // namespace dd
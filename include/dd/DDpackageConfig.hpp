@@ -18,12 +18,24 @@ struct DDPackageConfig {
   static constexpr std::size_t CT_VEC_KRON_NBUCKET = 4096U;
   static constexpr std::size_t CT_MAT_KRON_NBUCKET = 4096U;
   static constexpr std::size_t CT_VEC_INNER_PROD_NBUCKET = 4096U;
+  static constexpr std::size_t CT_MAT_TRACE_NBUCKET = 4096U;
+  static constexpr std::size_t CT_MAT_IDENTITY_NBUCKET = 4096U;
   static constexpr std::size_t CT_DM_NOISE_NBUCKET = 1U;
   static constexpr std::size_t UT_DM_NBUCKET = 1U;
   static constexpr std::size_t UT_DM_INITIAL_ALLOCATION_SIZE = 1U;
   static constexpr std::size_t CT_DM_DM_MULT_NBUCKET = 1U;
   static constexpr std::size_t CT_DM_ADD_NBUCKET = 1U;
 
+  // The number of entries per bucket (ways) of the binary compute tables
+  // (addition, multiplication, Kronecker and inner product). A value of one
+  // yields direct-mapped tables. Larger values trade memory for fewer evictions
+  // of frequently used entries (least-recently-used replacement).
+  static constexpr std::size_t CT_NWAYS = 1U;
+
+  // Whether the unique tables for DD nodes use open addressing (see
+  // OpenAddressingUniqueTable) instead of chained buckets (see UniqueTable).
+  static constexpr bool UT_OPEN_ADDRESSING = false;
+
   // The number of different quantum operations. I.e., the number of operations
   // defined in the QFR OpType.hpp This parameter is required to initialize the
   // StochasticNoiseOperationTable.hpp
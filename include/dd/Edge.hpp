@@ -2,6 +2,7 @@
 
 #include "dd/Complex.hpp"
 #include "dd/DDDefinitions.hpp"
+#include "dd/Traversal.hpp"
 
 #include <array>
 #include <complex>
@@ -9,7 +10,6 @@
 #include <functional>
 #include <string>
 #include <type_traits>
-#include <unordered_set>
 
 namespace dd {
 
@@ -133,12 +133,11 @@ template <class Node> struct Edge {
 
 private:
   /**
-   * @brief Recursively traverse the DD and count the number of nodes
+   * @brief Iteratively traverse the DD and count the number of nodes
    * @param visited set of visited nodes
    * @return the size of the DD
    */
-  [[nodiscard]] std::size_t
-  size(std::unordered_set<const Node*>& visited) const;
+  [[nodiscard]] std::size_t size(VisitedSet<Node>& visited) const;
 
   ///---------------------------------------------------------------------------
   ///                     \n Methods for vector DDs \n
@@ -204,9 +203,9 @@ public:
 
 private:
   /**
-   * @brief Recursively traverse the DD and call a function for each non-zero
-   * amplitude.
-   * @details Scales with the number of non-zero amplitudes.
+   * @brief Traverse the DD and call a function for each non-zero amplitude.
+   * @details Scales with the number of non-zero amplitudes. The traversal uses
+   * an explicit stack and, hence, supports arbitrarily deep DDs.
    * @tparam T template parameter to enable this function only for vNode
    * @param amp the accumulated amplitude from previous traversals
    * @param i the current index in the vector
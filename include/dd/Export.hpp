@@ -6,6 +6,7 @@
 #include "dd/Edge.hpp"
 #include "dd/Node.hpp"
 #include "dd/RealNumber.hpp"
+#include "dd/Traversal.hpp"
 
 #include <algorithm>
 #include <cmath>
@@ -867,40 +868,32 @@ export2Dot(Edge<Node> basic, const std::string& outputFilename,
   }
 }
 
-static void serializeMatrix(const mEdge& basic, std::int64_t& idx,
-                            std::unordered_map<mNode*, std::int64_t>& nodeIndex,
-                            std::unordered_set<mNode*>& visited,
-                            std::ostream& os, bool writeBinary = false) {
-  if (!basic.isTerminal()) {
-    for (auto& e : basic.p->e) {
-      if (visited.insert(e.p).second) {
-        serializeMatrix(e, idx, nodeIndex, visited, os, writeBinary);
-      }
-    }
-
-    if (nodeIndex.find(basic.p) == nodeIndex.end()) {
-      nodeIndex[basic.p] = idx;
-      ++idx;
-    }
+static void serializeMatrix(const mEdge& basic, std::ostream& os,
+                            bool writeBinary = false) {
+  std::int64_t idx = 0;
+  std::unordered_map<const mNode*, std::int64_t> nodeIndex{};
+  VisitedSet<mNode> visited{};
+  traversePostOrder(basic.p, visited, [&](const mNode* p) {
+    nodeIndex[p] = idx;
+    ++idx;
 
     if (writeBinary) {
-      os.write(reinterpret_cast<const char*>(&nodeIndex[basic.p]),
-               sizeof(decltype(nodeIndex[basic.p])));
-      os.write(reinterpret_cast<const char*>(&basic.p->v),
-               sizeof(decltype(basic.p->v)));
+      os.write(reinterpret_cast<const char*>(&nodeIndex[p]),
+               sizeof(decltype(nodeIndex[p])));
+      os.write(reinterpret_cast<const char*>(&p->v), sizeof(decltype(p->v)));
 
       // iterate over edges in reverse to guarantee correct processing order
-      for (auto& edge : basic.p->e) {
+      for (const auto& edge : p->e) {
         std::int64_t edgeIdx = edge.isTerminal() ? -1 : nodeIndex[edge.p];
         os.write(reinterpret_cast<const char*>(&edgeIdx),
                  sizeof(decltype(edgeIdx)));
         edge.w.writeBinary(os);
       }
     } else {
-      os << nodeIndex[basic.p] << " " << static_cast<std::size_t>(basic.p->v);
+      os << nodeIndex[p] << " " << static_cast<std::size_t>(p->v);
 
       // iterate over edges in reverse to guarantee correct processing order
-      for (auto& edge : basic.p->e) {
+      for (const auto& edge : p->e) {
         os << " (";
         if (!edge.w.approximatelyZero()) {
           const std::int64_t edgeIdx =
@@ -911,7 +904,7 @@ static void serializeMatrix(const mEdge& basic, std::int64_t& idx,
       }
       os << "\n";
     }
-  }
+  });
 }
 [[maybe_unused]] static void serialize(const mEdge& basic, std::ostream& os,
                                        bool writeBinary = false) {
@@ -924,10 +917,7 @@ static void serializeMatrix(const mEdge& basic, std::int64_t& idx,
     os << basic.w.toString(false, std::numeric_limits<dd::fp>::max_digits10)
        << "\n";
   }
-  std::int64_t idx = 0;
-  std::unordered_map<mNode*, std::int64_t> nodeIndex{};
-  std::unordered_set<mNode*> visited{};
-  serializeMatrix(basic, idx, nodeIndex, visited, os, writeBinary);
+  serializeMatrix(basic, os, writeBinary);
 }
 template <class Node>
 static void serialize(const Edge<Node>& basic,
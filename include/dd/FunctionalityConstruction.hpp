@@ -3,13 +3,32 @@
 #include "QuantumComputation.hpp"
 #include "algorithms/Grover.hpp"
 #include "dd/Operations.hpp"
+#include "dd/statistics/OperationTrace.hpp"
 
 namespace dd {
 using namespace qc;
 
+/**
+ * @brief Construct the functionality of a circuit
+ * @param qc The circuit.
+ * @param dd The package to use.
+ * @param tracer An optional tracer receiving per-operation figures (see
+ * OperationTracer). Tracing is disabled if it is null.
+ * @returns The functionality of the circuit.
+ */
 template <class Config>
-MatrixDD buildFunctionality(const QuantumComputation* qc, Package<Config>& dd);
+MatrixDD buildFunctionality(const QuantumComputation* qc, Package<Config>& dd,
+                            OperationTracer* tracer = nullptr);
 
+/**
+ * @brief Construct the functionality of a circuit by multiplying the
+ * operations in a balanced binary tree
+ * @details Since intermediate products do not correspond to single
+ * operations, this construction cannot be traced.
+ * @param qc The circuit.
+ * @param dd The package to use.
+ * @returns The functionality of the circuit.
+ */
 template <class Config>
 MatrixDD buildFunctionalityRecursive(const QuantumComputation* qc,
                                      Package<Config>& dd);
@@ -20,6 +39,26 @@ bool buildFunctionalityRecursive(const QuantumComputation* qc,
                                  std::stack<MatrixDD>& s,
                                  Permutation& permutation, Package<Config>& dd);
 
+/**
+ * @brief Construct the functionality of a circuit using multiple threads
+ * @details The circuit is split into contiguous ranges of operations, whose
+ * functionalities are constructed concurrently in separate worker packages.
+ * The worker packages use the memory budget and the parallel evaluation
+ * settings of @p dd (see Package::adoptSettings). The partial results are then
+ * multiplied pairwise up a balanced binary tree, where the products of every
+ * level are again computed concurrently. Partial results are moved between
+ * packages using `Package::transfer`.
+ * @param qc The circuit.
+ * @param dd The package to construct the functionality in.
+ * @param numThreads The number of threads. If zero, the number of hardware
+ * threads is used.
+ * @returns The functionality of the circuit.
+ */
+template <class Config>
+MatrixDD buildFunctionalityParallel(const QuantumComputation* qc,
+                                    Package<Config>& dd,
+                                    std::size_t numThreads = 0U);
+
 template <class Config>
 MatrixDD buildFunctionality(const qc::Grover* qc, Package<Config>& dd);
 
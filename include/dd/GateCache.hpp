@@ -0,0 +1,144 @@
+#pragma once
+
+#include "Definitions.hpp"
+#include "dd/statistics/TableStatistics.hpp"
+#include "operations/Control.hpp"
+#include "operations/OpType.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace dd {
+
+/**
+ * @brief Data structure for caching the DDs of quantum gates
+ * @details Gates with identical type, parameters, targets, and controls (after
+ * applying the permutation of the circuit) result in the same DD. The gate
+ * cache allows to retrieve these DDs via a single hash lookup instead of
+ * reconstructing and normalizing the nodes of the gate DD each time. In
+ * contrast to the compute tables, entries are persistent, i.e., they are not
+ * invalidated during regular garbage collection. To this end, the package
+ * owning the cache holds a reference to each cached DD (see
+ * Package::cacheGateDD).
+ * Once the maximum number of entries is reached, the cache has to be cleared
+ * by the owning package before inserting new entries.
+ * @tparam Edge The type of edges stored in the cache
+ */
+template <class Edge> class GateCache {
+public:
+  /// The key identifying a gate
+  struct Key {
+    qc::OpType type = qc::OpType::None;
+    bool inverse = false;
+    std::vector<qc::fp> parameter{};
+    std::vector<qc::Qubit> targets{};
+    qc::Controls controls{};
+    std::size_t nqubits = 0U;
+    std::size_t startQubit = 0U;
+
+    bool operator==(const Key& other) const {
+      return type == other.type && inverse == other.inverse &&
+             nqubits == other.nqubits && startQubit == other.startQubit &&
+             targets == other.targets && controls == other.controls &&
+             parameter == other.parameter;
+    }
+  };
+
+  /// The hash function for keys
+  struct KeyHash {
+    std::size_t operator()(const Key& key) const noexcept {
+      auto h = static_cast<std::size_t>(key.type);
+      qc::hashCombine(h, static_cast<std::size_t>(key.inverse));
+      qc::hashCombine(h, key.nqubits);
+      qc::hashCombine(h, key.startQubit);
+      for (const auto& p : key.parameter) {
+        qc::hashCombine(h, std::hash<qc::fp>{}(p));
+      }
+      for (const auto& t : key.targets) {
+        qc::hashCombine(h, static_cast<std::size_t>(t));
+      }
+      for (const auto& c : key.controls) {
+        qc::hashCombine(h, (static_cast<std::size_t>(c.qubit) << 1U) |
+                               static_cast<std::size_t>(c.type));
+      }
+      return h;
+    }
+  };
+
+  /// The default maximum number of entries
+  static constexpr std::size_t DEFAULT_MAX_ENTRIES = 4096U;
+
+  explicit GateCache(const std::size_t maxNumEntries = DEFAULT_MAX_ENTRIES)
+      : maxEntries(maxNumEntries) {
+    stats.entrySize = sizeof(Key) + sizeof(Edge);
+    stats.numBuckets = maxEntries;
+  }
+
+  /// Get a reference to the table
+  [[nodiscard]] const auto& getTable() const { return table; }
+
+  /// Get a reference to the statistics
+  [[nodiscard]] const auto& getStats() const noexcept { return stats; }
+
+  /// Get the maximum number of entries
+  [[nodiscard]] std::size_t getMaxEntries() const noexcept {
+    return maxEntries;
+  }
+
+  /// Check whether the maximum number of entries has been reached
+  [[nodiscard]] bool full() const noexcept {
+    return table.size() >= maxEntries;
+  }
+
+  /**
+   * @brief Insert a gate DD into the cache
+   * @details Existing entries for the same key are kept.
+   * @param key The key of the gate.
+   * @param e The DD of the gate.
+   * @returns Whether the entry was inserted.
+   */
+  bool insert(Key key, const Edge& e) {
+    const auto inserted = table.try_emplace(std::move(key), e).second;
+    if (inserted) {
+      stats.trackInsert();
+    }
+    return inserted;
+  }
+
+  /**
+   * @brief Look up a gate DD in the cache
+   * @param key The key of the gate.
+   * @returns A pointer to the cached DD or nullptr if no entry exists.
+   */
+  const Edge* lookup(const Key& key) {
+    ++stats.lookups;
+    const auto it = table.find(key);
+    if (it == table.end()) {
+      return nullptr;
+    }
+    ++stats.hits;
+    return &it->second;
+  }
+
+  /**
+   * @brief Remove all entries from the cache
+   * @details This does not release the references held on the cached DDs.
+   */
+  void clear() {
+    table.clear();
+    stats.numEntries = 0U;
+  }
+
+private:
+  /// The actual cache
+  std::unordered_map<Key, Edge, KeyHash> table{};
+  /// The maximum number of entries
+  std::size_t maxEntries;
+  /// A collection of statistics
+  TableStatistics stats{};
+};
+
+} // namespace dd
@@ -4,12 +4,21 @@
 #include "dd/statistics/MemoryManagerStatistics.hpp"
 
 #include <cstddef>
+#include <functional>
+#include <mutex>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 namespace dd {
 
+/**
+ * @brief A mapping from the previous to the new addresses of relocated entries
+ * @see MemoryManager::compact
+ */
+template <typename T> using Relocation = std::unordered_map<const T*, T*>;
+
 /**
  * @brief A memory manager for objects of type T.
  * @details The class manages a collection of objects of type T. The objects are
@@ -98,9 +107,58 @@ public:
    */
   void reset(bool resizeToTotal = false) noexcept;
 
+  /**
+   * @brief Release chunks in which no entry is in use anymore.
+   * @details Memory is handed back to the system in whole chunks only. This
+   * determines the chunks whose entries are all on the list of available
+   * entries, unlinks these entries from the list, and frees the chunks. The
+   * chunk that entries are currently taken from is always kept. Must not be
+   * called concurrently with any other member function.
+   * @return The number of bytes that have been released.
+   */
+  std::size_t releaseUnusedChunks();
+
+  /**
+   * @brief Relocate all entries in use into a single dense chunk.
+   * @details Copies every entry that is in use, i.e., that has been handed out
+   * and not been returned since, into a newly allocated chunk of exactly the
+   * required size, in the order of their previous addresses. Afterwards, all
+   * previous chunks are freed and the list of available entries is empty.
+   * Any pointer to an entry in use has to be updated via the returned
+   * relocation, including the `next` pointers of the relocated entries. The
+   * previous addresses must not be dereferenced anymore. Must not be called
+   * concurrently with any other member function.
+   * @return The mapping from the previous to the new address of each entry in
+   * use.
+   */
+  [[nodiscard]] Relocation<T> compact();
+
+  /**
+   * @brief Set a function that is invoked before a new chunk is allocated.
+   * @details The function receives the size of the new chunk in bytes. It may
+   * throw an exception to prevent the allocation, e.g., to enforce a memory
+   * budget. In that case, the manager remains unchanged.
+   * @param guard The function to invoke or an empty function to remove it.
+   */
+  void setAllocationGuard(std::function<void(std::size_t)> guard) {
+    allocationGuard = std::move(guard);
+  }
+
   /// Get a reference to the statistics
   [[nodiscard]] const auto& getStats() const noexcept { return stats; }
 
+  /**
+   * @brief Enable or disable concurrent access to the manager.
+   * @details If enabled, `get` and `returnEntry` may be called from multiple
+   * threads simultaneously. `reset` must still not be called concurrently with
+   * any other member function.
+   * @param enable Whether to enable concurrent access.
+   */
+  void setConcurrent(const bool enable) noexcept { concurrent = enable; }
+
+  /// Check whether concurrent access is enabled
+  [[nodiscard]] bool isConcurrent() const noexcept { return concurrent; }
+
 private:
   /**
    * @brief Check whether an entry is available for reuse
@@ -165,8 +223,17 @@ private:
    */
   typename std::vector<T>::iterator chunkEndIt;
 
+  /// The function invoked before a new chunk is allocated (if any)
+  std::function<void(std::size_t)> allocationGuard;
+
   /// Memory manager statistics
   MemoryManagerStatistics<T> stats{};
+
+  /// Whether concurrent access to the manager is enabled
+  bool concurrent = false;
+
+  /// The mutex guarding the manager if concurrent access is enabled
+  std::mutex mutex;
 };
 
 } // namespace dd
@@ -0,0 +1,535 @@
+#pragma once
+
+#include "dd/Concurrency.hpp"
+#include "dd/DDDefinitions.hpp"
+#include "dd/Edge.hpp"
+#include "dd/MemoryManager.hpp"
+#include "dd/Node.hpp"
+#include "dd/statistics/UniqueTableStatistics.hpp"
+#include "nlohmann/json.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dd {
+
+/**
+ * @brief Data structure for uniquely storing DD nodes using open addressing
+ * @details This is an alternative to the chained UniqueTable with the same
+ * interface. Instead of walking linked lists through the nodes themselves,
+ * each variable has a contiguous array of slots holding the full hash value of
+ * a node (used as a fingerprint) and a pointer to the node. Collisions are
+ * resolved by linear probing with robin hood insertion, which bounds the
+ * variance of probe sequence lengths and allows unsuccessful searches to stop
+ * early. Nodes are only dereferenced once their fingerprint matches.
+ * Once the load factor of the table of a variable exceeds the maximum load
+ * factor, the table is doubled. Since the hash values are stored in the slots,
+ * growing never rehashes any nodes. Dead nodes are removed during garbage
+ * collection via backward shift deletion, i.e., without tombstones.
+ * @tparam Node class of nodes to provide/store
+ * @tparam NBUCKET initial number of slots to use (has to be a power of two)
+ */
+template <class Node, std::size_t NBUCKET = 32768>
+class OpenAddressingUniqueTable {
+
+  static_assert(
+      std::disjunction_v<std::is_same<Node, vNode>, std::is_same<Node, mNode>,
+                         std::is_same<Node, dNode>>,
+      "Node type must be one of vNode, mNode, dNode");
+
+public:
+  /**
+   * @brief A slot of the table
+   * @details A slot is empty if its node pointer is null.
+   */
+  struct Slot {
+    /// The (unmasked) hash value of the node
+    std::size_t hash = 0U;
+    /// The node stored in the slot
+    Node* node = nullptr;
+  };
+
+  /**
+   * @brief The initial garbage collection limit.
+   * @details The initial garbage collection limit is the number of entries that
+   * must be present in the table before garbage collection is triggered.
+   * Increasing this number reduces the number of garbage collections, but
+   * increases the memory usage.
+   */
+  static constexpr std::size_t INITIAL_GC_LIMIT = 131072U;
+
+  /// The number of mutexes used to guard the tables in concurrent mode.
+  static constexpr std::size_t NUM_SHARDS = 64U;
+
+  /**
+   * @brief The minimum number of slots per variable.
+   * @details Open addressing requires at least one empty slot per table.
+   */
+  static constexpr std::size_t MIN_SLOTS = 8U;
+
+  /// The initial number of slots per variable
+  static constexpr std::size_t INITIAL_SLOTS = std::max(NBUCKET, MIN_SLOTS);
+
+  /**
+   * @brief The default maximum load factor.
+   * @details Once the ratio of occupied slots in the table of a variable
+   * exceeds this value, the table of that variable is grown.
+   */
+  static constexpr double DEFAULT_MAX_LOAD_FACTOR = 0.75;
+
+  /**
+   * @brief The default constructor
+   * @param nv The number of variables
+   * @param manager The memory manager to use for allocating new nodes.
+   * @param initialGCLim The initial garbage collection limit.
+   */
+  explicit OpenAddressingUniqueTable(
+      const std::size_t nv, MemoryManager<Node>& manager,
+      const std::size_t initialGCLim = INITIAL_GC_LIMIT)
+      : memoryManager(&manager), initialGCLimit(initialGCLim) {
+    resize(nv);
+  }
+
+  void resize(const std::size_t nq) {
+    nvars = nq;
+    tables.resize(nq, Table(INITIAL_SLOTS));
+    stats.resize(nq);
+    for (std::size_t v = 0U; v < nq; ++v) {
+      stats[v].entrySize = sizeof(Slot);
+      stats[v].numBuckets = tables[v].size();
+    }
+  }
+
+  /**
+   * @brief The hash function for the hash table.
+   * @details The hash function combines the hashes of the edges of the node.
+   * In contrast to the chained UniqueTable, the hash value is not masked since
+   * it is stored in the table as a fingerprint.
+   * @param p The node to hash.
+   * @returns The hash value of the node.
+   */
+  static std::size_t hash(const Node* p) {
+    std::size_t key = 0U;
+    for (std::size_t i = 0U; i < p->e.size(); ++i) {
+      qc::hashCombine(key, std::hash<Edge<Node>>{}(p->e[i]));
+    }
+    return key;
+  }
+
+  /**
+   * @brief Set the maximum load factor of the table.
+   * @param maxLoad The maximum load factor (must be in (0, 1)).
+   */
+  void setMaxLoadFactor(const double maxLoad) {
+    if (maxLoad <= 0. || maxLoad >= 1.) {
+      throw std::invalid_argument(
+          "Maximum load factor must be in the interval (0, 1).");
+    }
+    maxLoadFactor = maxLoad;
+  }
+
+  /// Get the maximum load factor of the table
+  [[nodiscard]] double getMaxLoadFactor() const noexcept {
+    return maxLoadFactor;
+  }
+
+  /// Get the current number of slots of the table for a variable
+  [[nodiscard]] std::size_t getNumBuckets(const std::size_t v) const {
+    return tables.at(v).size();
+  }
+
+  /// Get a reference to the table
+  [[nodiscard]] const auto& getTables() const { return tables; }
+
+  /// Get a reference to the statistics
+  [[nodiscard]] const auto& getStats() const noexcept { return stats; }
+
+  /// Get a reference to individual statistics
+  [[nodiscard]] const auto& getStats(const std::size_t idx) const noexcept {
+    return stats.at(idx);
+  }
+
+  /// Get a JSON object with the statistics
+  [[nodiscard]] nlohmann::json
+  getStatsJson(const bool includeIndividualTables = false) const {
+    if (std::all_of(stats.begin(), stats.end(),
+                    [](const UniqueTableStatistics& stat) {
+                      return stat.peakNumEntries == 0U;
+                    })) {
+      return "unused";
+    }
+
+    UniqueTableStatistics totalStats;
+    for (const auto& stat : stats) {
+      totalStats.entrySize = std::max(totalStats.entrySize, stat.entrySize);
+      totalStats.numBuckets += stat.numBuckets;
+      totalStats.numEntries += stat.numEntries;
+      totalStats.peakNumEntries += stat.peakNumEntries;
+      totalStats.collisions += stat.collisions;
+      totalStats.hits += stat.hits;
+      totalStats.lookups += stat.lookups;
+      totalStats.inserts += stat.inserts;
+      totalStats.numActiveEntries += stat.numActiveEntries;
+      totalStats.peakNumActiveEntries += stat.peakNumActiveEntries;
+      totalStats.gcRuns = std::max(totalStats.gcRuns, stat.gcRuns);
+    }
+
+    nlohmann::json j;
+    j["total"] = totalStats.json();
+    if (includeIndividualTables) {
+      std::size_t v = 0U;
+      for (const auto& stat : stats) {
+        j[std::to_string(v)] = stat.json();
+        ++v;
+      }
+    }
+    return j;
+  }
+
+  /// Get the total number of entries
+  [[nodiscard]] std::size_t getNumEntries() const noexcept {
+    return std::accumulate(
+        stats.begin(), stats.end(), std::size_t{0},
+        [](const std::size_t& sum, const UniqueTableStatistics& stat) {
+          return sum + stat.numEntries;
+        });
+  }
+
+  /// Get the total number of active entries
+  [[nodiscard]] std::size_t getNumActiveEntries() const noexcept {
+    return std::accumulate(
+        stats.begin(), stats.end(), std::size_t{0},
+        [](const std::size_t& sum, const UniqueTableStatistics& stat) {
+          return sum + stat.numActiveEntries;
+        });
+  }
+
+  /// Get the peak total number of active entries
+  [[nodiscard]] std::size_t getPeakNumActiveEntries() const noexcept {
+    return std::accumulate(
+        stats.begin(), stats.end(), std::size_t{0},
+        [](const std::size_t& sum, const UniqueTableStatistics& stat) {
+          return sum + stat.peakNumActiveEntries;
+        });
+  }
+
+  static bool nodesAreEqual(const Node* p, const Node* q) {
+    if constexpr (std::is_same_v<Node, dNode>) {
+      return (p->e == q->e && (p->flags == q->flags));
+    } else {
+      return p->e == q->e;
+    }
+  }
+
+  /**
+   * @brief Enable or disable concurrent access to the table.
+   * @details If enabled, `lookup` may be called from multiple threads
+   * simultaneously. The table is sharded by variable and each shard is guarded
+   * by its own mutex (see NUM_SHARDS). Reference counting, garbage collection,
+   * resizing, and clearing must still not be performed concurrently.
+   * @param enable Whether to enable concurrent access.
+   */
+  void setConcurrent(const bool enable) noexcept { concurrent = enable; }
+
+  /// Check whether concurrent access is enabled
+  [[nodiscard]] bool isConcurrent() const noexcept { return concurrent; }
+
+  // lookup a node in the unique table for the appropriate variable; insert it,
+  // if it has not been found NOTE: reference counting is to be adjusted by
+  // function invoking the table lookup and only normalized nodes shall be
+  // stored.
+  Node* lookup(Node* p) {
+    // there are unique terminal nodes
+    if (Node::isTerminal(p)) {
+      return p;
+    }
+
+    const auto h = hash(p);
+    const auto v = p->v;
+    const auto lock = conditionalLock(shards[v % NUM_SHARDS], concurrent);
+    auto& stat = stats[v];
+    ++stat.lookups;
+
+    auto& table = tables[v];
+    const auto mask = table.size() - 1U;
+    auto idx = h & mask;
+    std::size_t dist = 0U;
+    while (table[idx].node != nullptr &&
+           probeDistance(table[idx].hash, idx, mask) >= dist) {
+      if (const auto& slot = table[idx];
+          slot.hash == h && nodesAreEqual(p, slot.node)) {
+        if (p != slot.node) {
+          // put node pointed to by p on available chain
+          memoryManager->returnEntry(p);
+        }
+        ++stat.hits;
+        return slot.node;
+      }
+      ++stat.collisions;
+      idx = (idx + 1U) & mask;
+      ++dist;
+    }
+
+    // if node not found -> insert it at the position where the search stopped
+    place(table, Slot{h, p}, idx, dist);
+    stat.trackInsert();
+
+    if (static_cast<double>(stat.numEntries) >
+        maxLoadFactor * static_cast<double>(table.size())) {
+      grow(v);
+    }
+    return p;
+  }
+
+  /**
+   * @brief Increment the reference count of a node.
+   * @details This is a pass-through function that calls the increment function
+   * of the node. It additionally keeps track of the number of active entries
+   * in the table (entries with a reference count greater than zero). Reference
+   * counts saturate at the maximum value of RefCount.
+   * @param p A pointer to the node to increase the reference count of.
+   * @returns Whether the reference count was increased.
+   * @see Node::incRef(Node*)
+   */
+  [[nodiscard]] bool incRef(Node* p) noexcept {
+    const auto inc = ::dd::incRef(p);
+    if (inc && p->ref == 1U) {
+      stats[p->v].trackActiveEntry();
+    }
+    return inc;
+  }
+
+  /**
+   * @brief Decrement the reference count of a node.
+   * @details This is a pass-through function that calls the decrement function
+   * of the node. It additionally keeps track of the number of active entries
+   * in the table (entries with a reference count greater than zero). Reference
+   * counts saturate at the maximum value of RefCount.
+   * @param p A pointer to the node to decrease the reference count of.
+   * @returns Whether the reference count was decreased.
+   * @see Node::decRef(Node*)
+   */
+  [[nodiscard]] bool decRef(Node* p) noexcept {
+    const auto dec = ::dd::decRef(p);
+    if (dec && p->ref == 0U) {
+      --stats[p->v].numActiveEntries;
+    }
+    return dec;
+  }
+
+  [[nodiscard]] bool possiblyNeedsCollection() const {
+    return getNumEntries() >= gcLimit;
+  }
+
+  std::size_t garbageCollect(bool force = false) {
+    const std::size_t numEntriesBefore = getNumEntries();
+    if ((!force && numEntriesBefore < gcLimit) || numEntriesBefore == 0U) {
+      return 0U;
+    }
+
+    for (std::size_t v = 0U; v < tables.size(); ++v) {
+      auto& table = tables[v];
+      auto& stat = stats[v];
+      ++stat.gcRuns;
+      std::size_t idx = 0U;
+      while (idx < table.size()) {
+        auto* p = table[idx].node;
+        if (p != nullptr && p->ref == 0) {
+          memoryManager->returnEntry(p);
+          --stat.numEntries;
+          // the slot is refilled by the backward shift and has to be checked
+          // again
+          erase(table, idx);
+        } else {
+          ++idx;
+        }
+      }
+      stat.numActiveEntries = stat.numEntries;
+    }
+
+    // The garbage collection limit changes dynamically depending on the number
+    // of remaining (active) nodes (see UniqueTable::garbageCollect).
+    const auto numEntries = getNumEntries();
+    if (numEntries > gcLimit / 10 * 9) {
+      gcLimit = numEntries + initialGCLimit;
+    }
+    return numEntriesBefore - numEntries;
+  }
+
+  /**
+   * @brief Update the table after its nodes have been relocated
+   * @details Replaces every node in the table by its new address according to
+   * @p relocation (see MemoryManager::compact) and passes it to @p rewire,
+   * which is expected to update the edges of the node. Since the hash of a
+   * node depends on its edges, all slots are rehashed afterwards.
+   * @param relocation The mapping from previous to new node addresses.
+   * @param rewire The function updating the edges of a relocated node.
+   */
+  template <class Rewire>
+  void relocate(const Relocation<Node>& relocation, Rewire&& rewire) {
+    for (auto& table : tables) {
+      Table relocated(table.size());
+      const auto mask = relocated.size() - 1U;
+      for (const auto& slot : table) {
+        if (slot.node != nullptr) {
+          auto* p = relocation.at(slot.node);
+          rewire(p);
+          const auto h = hash(p);
+          place(relocated, Slot{h, p}, h & mask, 0U);
+        }
+      }
+      table = std::move(relocated);
+    }
+  }
+
+  void clear() {
+    // clear the slots and shrink the tables to their initial size
+    for (std::size_t v = 0U; v < tables.size(); ++v) {
+      tables[v].assign(INITIAL_SLOTS, Slot{});
+      stats[v].numBuckets = INITIAL_SLOTS;
+    }
+    gcLimit = initialGCLimit;
+    for (auto& stat : stats) {
+      stat.reset();
+    }
+  };
+
+  void print() {
+    auto q = nvars - 1U;
+    for (auto it = tables.rbegin(); it != tables.rend(); ++it) {
+      auto& table = *it;
+      std::cout << "\tq" << q << ":"
+                << "\n";
+      for (std::size_t idx = 0; idx < table.size(); ++idx) {
+        const auto* p = table[idx].node;
+        if (p == nullptr) {
+          continue;
+        }
+        std::cout << "\tslot=" << idx << ": " << std::hex
+                  << reinterpret_cast<std::uintptr_t>(p) << std::dec << " "
+                  << p->ref << std::hex;
+        for (const auto& e : p->e) {
+          std::cout << " p" << reinterpret_cast<std::uintptr_t>(e.p) << "(r"
+                    << reinterpret_cast<std::uintptr_t>(e.w.r) << " i"
+                    << reinterpret_cast<std::uintptr_t>(e.w.i) << ")";
+        }
+        std::cout << std::dec << "\n";
+      }
+      --q;
+    }
+  }
+
+private:
+  /// Typedef for the table of a single variable
+  using Table = std::vector<Slot>;
+
+  /// The number of variables
+  std::size_t nvars = 0U;
+
+  /// One table of slots per variable
+  std::vector<Table> tables;
+
+  /// The maximum load factor before a table is grown
+  double maxLoadFactor = DEFAULT_MAX_LOAD_FACTOR;
+
+  /// A pointer to the memory manager for the nodes stored in the table.
+  MemoryManager<Node>* memoryManager;
+
+  /// A collection of statistics
+  std::vector<UniqueTableStatistics> stats;
+
+  /// The initial garbage collection limit
+  std::size_t initialGCLimit;
+
+  /// The current garbage collection limit
+  std::size_t gcLimit = initialGCLimit;
+
+  /// Whether concurrent access is enabled
+  bool concurrent = false;
+  /// Mutexes guarding the tables in concurrent mode
+  std::array<std::mutex, NUM_SHARDS> shards{};
+
+  /**
+   * @brief Get the distance of a slot from the slot its hash value maps to
+   * @param h The hash value stored in the slot.
+   * @param idx The index of the slot.
+   * @param mask The mask of the table.
+   * @returns The probe sequence length of the slot.
+   */
+  static std::size_t probeDistance(const std::size_t h, const std::size_t idx,
+                                   const std::size_t mask) noexcept {
+    return (idx - (h & mask)) & mask;
+  }
+
+  /**
+   * @brief Place a slot in the table using robin hood insertion
+   * @details Starting at the given index, entries that are closer to their
+   * home slot than the entry being inserted are displaced and moved further
+   * down the probe sequence.
+   * @param table The table to insert into.
+   * @param slot The slot to insert.
+   * @param idx The index to start at.
+   * @param dist The probe distance of the slot at the given index.
+   */
+  static void place(Table& table, Slot slot, std::size_t idx,
+                    std::size_t dist) noexcept {
+    const auto mask = table.size() - 1U;
+    while (table[idx].node != nullptr) {
+      if (const auto existing = probeDistance(table[idx].hash, idx, mask);
+          existing < dist) {
+        std::swap(slot, table[idx]);
+        dist = existing;
+      }
+      idx = (idx + 1U) & mask;
+      ++dist;
+    }
+    table[idx] = slot;
+  }
+
+  /**
+   * @brief Remove the entry in the given slot via backward shift deletion
+   * @param table The table to remove from.
+   * @param idx The index of the slot to clear.
+   */
+  static void erase(Table& table, std::size_t idx) noexcept {
+    const auto mask = table.size() - 1U;
+    auto next = (idx + 1U) & mask;
+    while (table[next].node != nullptr &&
+           probeDistance(table[next].hash, next, mask) > 0U) {
+      table[idx] = table[next];
+      idx = next;
+      next = (next + 1U) & mask;
+    }
+    table[idx] = Slot{};
+  }
+
+  /**
+   * @brief Double the number of slots of the table of a variable
+   * @details The stored hash values are reused, so no node is accessed.
+   * @param v The variable whose table to grow.
+   */
+  void grow(const std::size_t v) {
+    auto& table = tables[v];
+    Table newTable(table.size() * 2U);
+    const auto mask = newTable.size() - 1U;
+    for (const auto& slot : table) {
+      if (slot.node != nullptr) {
+        place(newTable, slot, slot.hash & mask, 0U);
+      }
+    }
+    table = std::move(newTable);
+    stats[v].numBuckets = table.size();
+  }
+};
+
+} // namespace dd
@@ -7,20 +7,18 @@
 #include "operations/OpType.hpp"
 #include "operations/StandardOperation.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <utility>
 #include <variant>
 
 namespace dd {
-// single-target Operations
-template <class Config>
-qc::MatrixDD
-getStandardOperationDD(const qc::StandardOperation* op, Package<Config>& dd,
-                       const qc::Controls& controls, const qc::Qubit target,
-                       const bool inverse) {
+// matrix of single-target Operations
+inline GateMatrix getStandardOperationMatrix(const qc::StandardOperation* op,
+                                             const bool inverse) {
   GateMatrix gm;
 
   const auto type = op->getType();
-  const auto nqubits = op->getNqubits();
-  const auto startQubit = op->getStartingQubit();
   const auto& parameter = op->getParameter();
 
   switch (type) {
@@ -88,17 +86,27 @@ getStandardOperationDD(const qc::StandardOperation* op, Package<Config>& dd,
     oss << "DD for gate" << op->getName() << " not available!";
     throw qc::QFRException(oss.str());
   }
-  return dd.makeGateDD(gm, nqubits, controls, target, startQubit);
+  return gm;
 }
 
-// two-target Operations
+// single-target Operations on the given number of qubits
 template <class Config>
 qc::MatrixDD
 getStandardOperationDD(const qc::StandardOperation* op, Package<Config>& dd,
-                       const qc::Controls& controls, qc::Qubit target0,
-                       qc::Qubit target1, const bool inverse) {
+                       const std::size_t nqubits, const qc::Controls& controls,
+                       const qc::Qubit target, const bool inverse) {
+  return dd.makeGateDD(getStandardOperationMatrix(op, inverse), nqubits,
+                       controls, target, op->getStartingQubit());
+}
+
+// two-target Operations on the given number of qubits
+template <class Config>
+qc::MatrixDD
+getStandardOperationDD(const qc::StandardOperation* op, Package<Config>& dd,
+                       const std::size_t nqubits, const qc::Controls& controls,
+                       qc::Qubit target0, qc::Qubit target1,
+                       const bool inverse) {
   const auto type = op->getType();
-  const auto nqubits = op->getNqubits();
   const auto startQubit = op->getStartingQubit();
   const auto& parameter = op->getParameter();
 
@@ -160,6 +168,41 @@ getStandardOperationDD(const qc::StandardOperation* op, Package<Config>& dd,
                                startQubit);
 }
 
+// standard Operations on the given number of qubits. Repeated gates are served
+// from the gate cache of the package.
+template <class Config>
+qc::MatrixDD getCachedStandardOperationDD(const qc::StandardOperation* op,
+                                          Package<Config>& dd,
+                                          const qc::Targets& targets,
+                                          const qc::Controls& controls,
+                                          const std::size_t nqubits,
+                                          const bool inverse) {
+  const auto type = op->getType();
+  typename Package<Config>::GateKey key{type,
+                                        inverse,
+                                        op->getParameter(),
+                                        targets,
+                                        controls,
+                                        nqubits,
+                                        op->getStartingQubit()};
+  if (const auto cached = dd.lookupGateDD(key); cached.has_value()) {
+    return *cached;
+  }
+
+  qc::MatrixDD e{};
+  if (qc::isTwoQubitGate(type)) {
+    assert(targets.size() == 2);
+    e = getStandardOperationDD(op, dd, nqubits, controls, targets[0U],
+                               targets[1U], inverse);
+  } else {
+    assert(targets.size() == 1);
+    e = getStandardOperationDD(op, dd, nqubits, controls, targets[0U],
+                               inverse);
+  }
+  dd.cacheGateDD(std::move(key), e);
+  return e;
+}
+
 // The methods with a permutation parameter apply these Operations according to
 // the mapping specified by the permutation, e.g.
 //      if perm[0] = 1 and perm[1] = 0
@@ -218,14 +261,8 @@ qc::MatrixDD getDD(const qc::Operation* op, Package<Config>& dd,
       controls = permutation.apply(controls);
     }
 
-    if (qc::isTwoQubitGate(type)) {
-      assert(targets.size() == 2);
-      return getStandardOperationDD(standardOp, dd, controls, targets[0U],
-                                    targets[1U], inverse);
-    }
-    assert(targets.size() == 1);
-    return getStandardOperationDD(standardOp, dd, controls, targets[0U],
-                                  inverse);
+    return getCachedStandardOperationDD(standardOp, dd, targets, controls,
+                                        nqubits, inverse);
   }
 
   if (const auto* compoundOp = dynamic_cast<const qc::CompoundOperation*>(op)) {
@@ -269,6 +306,126 @@ qc::MatrixDD getInverseDD(const qc::Operation* op, Package<Config>& dd,
   return getDD(op, dd, permutation, true);
 }
 
+/**
+ * @brief Get the DD of a standard operation on the qubits it spans
+ * @details In contrast to getDD, the DD is not extended to all qubits of the
+ * circuit but ends at the highest qubit the operation acts on. It has to be
+ * applied via Package::multiplyExtended, which treats all qubits above as
+ * the identity. Hence, the cost of constructing the DD does not depend on the
+ * number of qubits above the operation.
+ * @param op The operation.
+ * @param dd The DD package to use.
+ * @param permutation The current permutation of the qubits.
+ * @param inverse Whether to get the DD of the inverse operation.
+ * @returns The DD of the operation.
+ */
+template <class Config>
+qc::MatrixDD getLocalDD(const qc::StandardOperation* op, Package<Config>& dd,
+                        const qc::Permutation& permutation,
+                        const bool inverse = false) {
+  auto targets = op->getTargets();
+  auto controls = op->getControls();
+  if (!permutation.empty()) {
+    targets = permutation.apply(targets);
+    controls = permutation.apply(controls);
+  }
+  auto highest = *std::max_element(targets.begin(), targets.end());
+  if (!controls.empty()) {
+    highest = std::max(highest, controls.rbegin()->qubit);
+  }
+  const auto nqubits =
+      static_cast<std::size_t>(highest) + 1U - op->getStartingQubit();
+  return getCachedStandardOperationDD(op, dd, targets, controls, nqubits,
+                                      inverse);
+}
+
+/**
+ * @brief Get the standard operation to apply via its local DD (if any)
+ * @details Classic-controlled operations are unwrapped. Global phases,
+ * barriers and SWAP gates that are only tracked in the permutation are not
+ * applied locally.
+ */
+inline const qc::StandardOperation*
+getLocallyApplicableOperation(const qc::Operation* op,
+                              const qc::Permutation& permutation) {
+  const auto* standardOp = dynamic_cast<const qc::StandardOperation*>(op);
+  if (const auto* classicOp =
+          dynamic_cast<const qc::ClassicControlledOperation*>(op)) {
+    standardOp =
+        dynamic_cast<const qc::StandardOperation*>(classicOp->getOperation());
+  }
+  if (standardOp == nullptr) {
+    return nullptr;
+  }
+  const auto type = standardOp->getType();
+  if (type == qc::GPhase || type == qc::Barrier ||
+      (type == qc::SWAP && !standardOp->isControlled() &&
+       !permutation.empty())) {
+    return nullptr;
+  }
+  return standardOp;
+}
+
+/**
+ * @brief Apply a unitary operation to a matrix DD
+ * @details Standard operations are applied via their local DD (see getLocalDD
+ * and Package::multiplyExtended). All other operations are applied by
+ * multiplying with their DD (see getDD). Classic-controlled operations are
+ * applied unconditionally.
+ * @param op The operation to apply.
+ * @param in The matrix DD to apply the operation to (from the left).
+ * @param dd The DD package to use.
+ * @param permutation The current permutation of the qubits.
+ * @returns The resulting matrix DD.
+ */
+template <class Config>
+qc::MatrixDD applyUnitaryOperation(const qc::Operation* op,
+                                   const qc::MatrixDD& in, Package<Config>& dd,
+                                   qc::Permutation& permutation) {
+  if (const auto* standardOp = getLocallyApplicableOperation(op, permutation);
+      standardOp != nullptr) {
+    return dd.multiplyExtended(getLocalDD(standardOp, dd, permutation), in);
+  }
+  return dd.multiply(getDD(op, dd, permutation), in);
+}
+
+/**
+ * @brief Apply a unitary operation to a vector DD
+ * @details Single-target standard operations are applied via the matrix-free
+ * Package::applyGate. Other standard operations are applied via their local
+ * DD (see getLocalDD and Package::multiplyExtended). All remaining operations
+ * are applied by multiplying with their DD (see getDD). Classic-controlled
+ * operations are applied unconditionally, i.e., the classical condition has to
+ * be checked by the caller.
+ * @param op The operation to apply.
+ * @param in The vector DD to apply the operation to.
+ * @param dd The DD package to use.
+ * @param permutation The current permutation of the qubits.
+ * @returns The resulting vector DD.
+ */
+template <class Config>
+qc::VectorDD applyUnitaryOperation(const qc::Operation* op,
+                                   const qc::VectorDD& in, Package<Config>& dd,
+                                   qc::Permutation& permutation) {
+  const auto* standardOp = getLocallyApplicableOperation(op, permutation);
+  if (standardOp == nullptr) {
+    return dd.multiply(getDD(op, dd, permutation), in);
+  }
+  if (qc::isTwoQubitGate(standardOp->getType())) {
+    return dd.multiplyExtended(getLocalDD(standardOp, dd, permutation), in);
+  }
+
+  auto targets = standardOp->getTargets();
+  auto controls = standardOp->getControls();
+  if (!permutation.empty()) {
+    targets = permutation.apply(targets);
+    controls = permutation.apply(controls);
+  }
+  assert(targets.size() == 1);
+  return dd.applyGate(in, getStandardOperationMatrix(standardOp, false),
+                      targets[0U], controls);
+}
+
 template <class Config>
 void dumpTensor(qc::Operation* op, std::ostream& of,
                 std::vector<std::size_t>& inds, std::size_t& gateIdx,
@@ -10,19 +10,25 @@
 #include "dd/DDpackageConfig.hpp"
 #include "dd/DensityNoiseTable.hpp"
 #include "dd/Edge.hpp"
+#include "dd/GateCache.hpp"
 #include "dd/GateMatrixDefinitions.hpp"
 #include "dd/MemoryManager.hpp"
 #include "dd/Node.hpp"
+#include "dd/OpenAddressingUniqueTable.hpp"
 #include "dd/Package_fwd.hpp"
 #include "dd/RealNumber.hpp"
 #include "dd/RealNumberUniqueTable.hpp"
+#include "dd/Snapshot.hpp"
 #include "dd/StochasticNoiseOperationTable.hpp"
+#include "dd/ThreadPool.hpp"
+#include "dd/Traversal.hpp"
 #include "dd/UnaryComputeTable.hpp"
 #include "dd/UniqueTable.hpp"
 #include "operations/Control.hpp"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <bitset>
 #include <cassert>
 #include <cmath>
@@ -30,10 +36,12 @@
 #include <cstddef>
 #include <cstdint>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <iterator>
 #include <limits>
 #include <map>
+#include <memory>
 #include <optional>
 #include <queue>
 #include <random>
@@ -44,12 +52,20 @@
 #include <string>
 #include <type_traits>
 #include <unordered_map>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
 namespace dd {
 
+/**
+ * @brief Exception thrown if the memory budget of a package is exceeded
+ * @see Package::setMemoryBudget
+ */
+class MemoryBudgetExceeded : public std::runtime_error {
+public:
+  using std::runtime_error::runtime_error;
+};
+
 template <class Config> class Package {
   static_assert(std::is_base_of_v<DDPackageConfig, Config>,
                 "Config must be derived from DDPackageConfig");
@@ -89,6 +105,9 @@ public:
 
   // reset package state
   void reset() {
+    // all nodes are released below, so the references held by the gate cache
+    // need not be released individually
+    gateCache.clear();
     clearUniqueTables();
     resetMemoryManagers();
     clearComputeTables();
@@ -144,12 +163,25 @@ public:
     cMemoryManager.reset(resizeToTotal);
   }
 
+  /**
+   * @brief The type of unique table used for DD nodes
+   * @see DDPackageConfig::UT_OPEN_ADDRESSING
+   */
+  template <class Node, std::size_t NBUCKET>
+  using NodeUniqueTable =
+      std::conditional_t<Config::UT_OPEN_ADDRESSING,
+                         OpenAddressingUniqueTable<Node, NBUCKET>,
+                         UniqueTable<Node, NBUCKET>>;
+
   /// The unique table used for vector nodes
-  UniqueTable<vNode, Config::UT_VEC_NBUCKET> vUniqueTable{0U, vMemoryManager};
+  NodeUniqueTable<vNode, Config::UT_VEC_NBUCKET> vUniqueTable{0U,
+                                                              vMemoryManager};
   /// The unique table used for matrix nodes
-  UniqueTable<mNode, Config::UT_MAT_NBUCKET> mUniqueTable{0U, mMemoryManager};
+  NodeUniqueTable<mNode, Config::UT_MAT_NBUCKET> mUniqueTable{0U,
+                                                              mMemoryManager};
   /// The unique table used for density matrix nodes
-  UniqueTable<dNode, Config::UT_DM_NBUCKET> dUniqueTable{0U, dMemoryManager};
+  NodeUniqueTable<dNode, Config::UT_DM_NBUCKET> dUniqueTable{0U,
+                                                             dMemoryManager};
   /**
    * @brief The unique table used for complex numbers
    * @note The table actually only stores real numbers in the interval [0, 1],
@@ -188,6 +220,85 @@ public:
     cUniqueTable.clear();
   }
 
+  /**
+   * @brief Enable or disable concurrent access to the node and number stores
+   * @details In concurrent mode, the memory managers and unique tables of the
+   * package are synchronized so that DD nodes and complex numbers can be
+   * created from multiple threads against one shared canonical store, e.g.,
+   * via `makeDDNode` or `cn.lookup`. The node tables are sharded by variable,
+   * while the memory managers and the real number table are guarded by a
+   * single mutex each. The same holds for the compute tables of vector and
+   * matrix addition and multiplication. Reference counting, garbage
+   * collection, and resetting the package are not synchronized and must only
+   * be performed while no other thread operates on the package.
+   * @param enable Whether to enable concurrent access.
+   */
+  void setConcurrent(const bool enable) noexcept {
+    vMemoryManager.setConcurrent(enable);
+    mMemoryManager.setConcurrent(enable);
+    dMemoryManager.setConcurrent(enable);
+    cMemoryManager.setConcurrent(enable);
+    vUniqueTable.setConcurrent(enable);
+    mUniqueTable.setConcurrent(enable);
+    dUniqueTable.setConcurrent(enable);
+    cUniqueTable.setConcurrent(enable);
+    vectorAdd.setConcurrent(enable);
+    matrixAdd.setConcurrent(enable);
+    matrixVectorMultiplication.setConcurrent(enable);
+    matrixMatrixMultiplication.setConcurrent(enable);
+  }
+
+  /// Check whether concurrent access to the package is enabled
+  [[nodiscard]] bool isConcurrent() const noexcept {
+    return vUniqueTable.isConcurrent();
+  }
+
+  ///
+  /// Parallel evaluation
+  ///
+
+  /// The default number of recursion levels that are evaluated in parallel
+  static constexpr std::size_t DEFAULT_PARALLEL_DEPTH_CUTOFF = 3U;
+
+  /**
+   * @brief Enable the parallel evaluation of additions and multiplications
+   * @details In parallel mode, the recursive calls of `add` and `multiply` for
+   * vector and matrix DDs are spawned as tasks on a work-stealing thread pool
+   * for the topmost @p depthCutoff levels of the recursion. Below the cutoff,
+   * the serial implementation is used. This also enables concurrent access to
+   * the package (see setConcurrent). Density matrix operations are always
+   * evaluated serially.
+   * @param numThreads The number of worker threads. If zero, the number of
+   * hardware threads is used.
+   * @param depthCutoff The number of recursion levels to evaluate in parallel.
+   */
+  void enableParallelEvaluation(
+      const std::size_t numThreads = 0U,
+      const std::size_t depthCutoff = DEFAULT_PARALLEL_DEPTH_CUTOFF) {
+    threadPool = std::make_unique<ThreadPool>(numThreads);
+    parallelDepthCutoff = depthCutoff;
+    setConcurrent(true);
+  }
+
+  /// Disable the parallel evaluation and shut down the worker threads
+  void disableParallelEvaluation() {
+    threadPool.reset();
+    setConcurrent(false);
+  }
+
+  /// Check whether the parallel evaluation is enabled
+  [[nodiscard]] bool isParallelEvaluationEnabled() const noexcept {
+    return threadPool != nullptr;
+  }
+
+private:
+  /// The thread pool used for the parallel evaluation (if enabled)
+  std::unique_ptr<ThreadPool> threadPool;
+  /// The number of recursion levels evaluated in parallel
+  std::size_t parallelDepthCutoff = DEFAULT_PARALLEL_DEPTH_CUTOFF;
+
+public:
+
   /**
    * @brief Increment the reference count of an edge
    * @details This is the main function for increasing reference counts within
@@ -231,6 +342,26 @@ public:
   }
 
   bool garbageCollect(bool force = false) {
+    // approaching the memory budget always triggers a full collection
+    const auto underMemoryPressure =
+        memoryBudget > 0U &&
+        static_cast<double>(getMemoryUsage()) >=
+            MEMORY_BUDGET_COLLECTION_THRESHOLD *
+                static_cast<double>(memoryBudget);
+    force |= underMemoryPressure;
+
+    // the gate cache only survives regular garbage collections, so that a
+    // forced collection frees everything that is not referenced by the user
+    if (force) {
+      clearGateCache();
+    }
+
+    // garbage collection is triggered between operations, which is the point
+    // where compute tables can safely be resized
+    if (computeTableSizeLimit > 0U && !underMemoryPressure) {
+      growComputeTables();
+    }
+
     // return immediately if no table needs collection
     if (!force && !vUniqueTable.possiblyNeedsCollection() &&
         !mUniqueTable.possiblyNeedsCollection() &&
@@ -249,45 +380,438 @@ public:
     auto mCollect = mUniqueTable.garbageCollect(force);
     auto dCollect = dUniqueTable.garbageCollect(force);
 
-    // invalidate all compute tables involving vectors if any vector node has
-    // been collected
-    if (vCollect > 0) {
-      vectorAdd.clear();
-      vectorInnerProduct.clear();
-      vectorKronecker.clear();
-      matrixVectorMultiplication.clear();
-    }
-    // invalidate all compute tables involving matrices if any matrix node has
-    // been collected
-    if (mCollect > 0 || dCollect > 0) {
-      matrixAdd.clear();
-      conjugateMatrixTranspose.clear();
-      matrixKronecker.clear();
-      matrixVectorMultiplication.clear();
-      matrixMatrixMultiplication.clear();
-      clearIdentityTable();
-      stochasticNoiseOperationCache.clear();
-      densityAdd.clear();
-      densityDensityMultiplication.clear();
-      densityNoise.clear();
-    }
-    // invalidate all compute tables where any component of the entry contains
-    // numbers from the complex table if any complex numbers were collected
-    if (cCollect > 0) {
-      matrixVectorMultiplication.clear();
-      matrixMatrixMultiplication.clear();
-      conjugateMatrixTranspose.clear();
-      vectorInnerProduct.clear();
-      vectorKronecker.clear();
-      matrixKronecker.clear();
-      stochasticNoiseOperationCache.clear();
-      densityAdd.clear();
-      densityDensityMultiplication.clear();
-      densityNoise.clear();
+    // only invalidate the compute table entries that refer to collected data
+    const CollectedData collected{vCollect > 0, mCollect > 0, dCollect > 0,
+                                  cCollect > 0};
+    if (collected.any()) {
+      invalidateComputeTables(collected);
+    }
+    if (underMemoryPressure) {
+      enforceMemoryBudget();
     }
     return vCollect > 0 || mCollect > 0 || cCollect > 0;
   }
 
+private:
+  /**
+   * @brief The kinds of data reclaimed by a garbage collection
+   * @details Collected nodes and numbers are returned to their memory manager
+   * with a reference count of zero and are not reused before the next
+   * allocation. Directly after a collection, a reference to a node or number
+   * of a collected kind thus refers to reclaimed data if and only if the
+   * reference count of the pointee is zero.
+   */
+  struct CollectedData {
+    bool vNodes = false;
+    bool mNodes = false;
+    bool dNodes = false;
+    bool numbers = false;
+
+    [[nodiscard]] bool any() const noexcept {
+      return vNodes || mNodes || dNodes || numbers;
+    }
+
+    /// Check whether a (possibly flagged) node pointer refers to collected data
+    template <class Node>
+    [[nodiscard]] bool refersTo(const Node* p) const noexcept {
+      if constexpr (std::is_same_v<Node, vNode>) {
+        if (!vNodes) {
+          return false;
+        }
+      } else if constexpr (std::is_same_v<Node, mNode>) {
+        if (!mNodes) {
+          return false;
+        }
+      } else if (!dNodes) {
+        return false;
+      }
+      constexpr std::uintptr_t flagMask = alignof(Node) - 1U;
+      const auto* node = reinterpret_cast<const Node*>(
+          reinterpret_cast<std::uintptr_t>(p) & ~flagMask);
+      return !Node::isTerminal(node) && node->ref == 0U;
+    }
+
+    /// Check whether a real number pointer refers to collected data
+    [[nodiscard]] bool refersTo(const RealNumber* r) const noexcept {
+      if (!numbers) {
+        return false;
+      }
+      const auto* num = RealNumber::getAlignedPointer(r);
+      return !RealNumber::noRefCountingNeeded(num) && num->ref == 0U;
+    }
+
+    template <class Node>
+    [[nodiscard]] bool refersTo(const Edge<Node>& e) const noexcept {
+      return refersTo(e.p) || refersTo(e.w.r) || refersTo(e.w.i);
+    }
+
+    template <class Node>
+    [[nodiscard]] bool refersTo(const CachedEdge<Node>& e) const noexcept {
+      return refersTo(e.p);
+    }
+
+    /// Plain values (e.g., counts or flags) never refer to collected data
+    template <class T, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    [[nodiscard]] bool refersTo(const T /*value*/) const noexcept {
+      return false;
+    }
+  };
+
+  /**
+   * @brief Invalidate the compute table entries referring to collected data
+   * @details In contrast to clearing the compute tables, all entries whose
+   * operands and result are still alive are preserved, so that they can be
+   * reused by the operations following the garbage collection.
+   */
+  void invalidateComputeTables(const CollectedData& collected) {
+    const auto refersToCollected = [&collected](const auto& entry) {
+      return collected.refersTo(entry.leftOperand) ||
+             collected.refersTo(entry.rightOperand) ||
+             collected.refersTo(entry.result);
+    };
+    applyToComputeTables([&refersToCollected](auto& table) {
+      table.invalidateIf(refersToCollected);
+    });
+
+    const auto refersToCollectedUnary = [&collected](const auto& entry) {
+      return collected.refersTo(entry.operand) ||
+             collected.refersTo(entry.result);
+    };
+    conjugateMatrixTranspose.invalidateIf(refersToCollectedUnary);
+    densityNoise.invalidateIf(refersToCollectedUnary);
+    stochasticNoiseOperationCache.invalidateIf(
+        [&collected](const mEdge& e) { return collected.refersTo(e); });
+    for (auto& entry : idTable) {
+      if (collected.refersTo(entry)) {
+        entry.p = nullptr;
+      }
+    }
+  }
+
+public:
+  ///
+  /// Memory budget
+  ///
+
+  /// The fraction of the memory budget from which on collections are forced
+  static constexpr double MEMORY_BUDGET_COLLECTION_THRESHOLD = 0.9;
+
+  /**
+   * @brief Limit the amount of memory held by the package
+   * @details With a budget set, the package keeps track of the memory held by
+   * its memory managers, unique tables, and compute tables (see
+   * getMemoryUsage). Once the usage reaches MEMORY_BUDGET_COLLECTION_THRESHOLD
+   * of the budget, every invocation of `garbageCollect` performs a full
+   * collection, flushes all compute tables, shrinks them to their initial size,
+   * and (optionally) returns chunks of memory that are no longer used to the
+   * system. If the memory that remains in use still exceeds the budget, or if
+   * an operation requires more memory for new nodes or numbers than the budget
+   * permits, a MemoryBudgetExceeded exception is thrown. The exception leaves
+   * the package in a consistent state, i.e., the DDs referenced before the
+   * failed operation remain valid.
+   * The budget is also enforced during parallel evaluation (see
+   * enableParallelEvaluation). There, allocations are accounted for by an
+   * atomic counter that is synchronized with the actual usage at the start of
+   * every parallel operation, and all running tasks are awaited before the
+   * exception is propagated. Growth of the unique tables during a parallel
+   * operation is only accounted for from the next operation on.
+   * @param bytes The budget in bytes. A value of zero (the default) disables
+   * the budget.
+   * @param releaseChunks Whether unused chunks of memory are released when the
+   * budget is approached.
+   */
+  void setMemoryBudget(const std::size_t bytes,
+                       const bool releaseChunks = false) {
+    memoryBudget = bytes;
+    releaseChunksUnderPressure = releaseChunks;
+    auto guard = std::function<void(std::size_t)>{};
+    if (bytes > 0U) {
+      guard = [this](const std::size_t additionalBytes) {
+        reserveMemory(additionalBytes);
+      };
+    }
+    vMemoryManager.setAllocationGuard(guard);
+    mMemoryManager.setAllocationGuard(guard);
+    dMemoryManager.setAllocationGuard(guard);
+    cMemoryManager.setAllocationGuard(guard);
+  }
+
+  /// Get the memory budget in bytes (zero if no budget is set)
+  [[nodiscard]] std::size_t getMemoryBudget() const noexcept {
+    return memoryBudget;
+  }
+
+  /**
+   * @brief Take over the resource settings of another package
+   * @details Applies the memory budget (see setMemoryBudget) and, if enabled,
+   * the parallel evaluation settings (see enableParallelEvaluation) of
+   * @p other. This is used for worker packages that carry out parts of a
+   * computation on behalf of @p other. The budget applies to every package
+   * individually.
+   * @param other The package to take the settings from.
+   */
+  void adoptSettings(const Package& other) {
+    setMemoryBudget(other.memoryBudget, other.releaseChunksUnderPressure);
+    if (other.isParallelEvaluationEnabled()) {
+      enableParallelEvaluation(other.threadPool->size(),
+                               other.parallelDepthCutoff);
+    }
+  }
+
+  /**
+   * @brief Get the amount of memory held by the package
+   * @details Accounts for the chunks allocated by the memory managers as well
+   * as for the buckets of the unique tables and the binary compute tables.
+   * Fixed-size tables (e.g., for unary operations) are not included.
+   * @returns The memory usage in bytes.
+   */
+  [[nodiscard]] std::size_t getMemoryUsage() const noexcept {
+    auto bytes = getMemoryManagerUsage();
+    const auto tableBytes = [](const auto& stats) {
+      return stats.numBuckets * stats.entrySize;
+    };
+    const auto uniqueTableBytes = [&tableBytes](const auto& table) {
+      std::size_t total = 0U;
+      for (const auto& stats : table.getStats()) {
+        total += tableBytes(stats);
+      }
+      return total;
+    };
+
+    bytes += uniqueTableBytes(vUniqueTable) + uniqueTableBytes(mUniqueTable) +
+             uniqueTableBytes(dUniqueTable) +
+             tableBytes(cUniqueTable.getStats());
+    applyToComputeTables([&bytes, &tableBytes](const auto& table) {
+      bytes += tableBytes(table.getStats());
+    });
+    return bytes;
+  }
+
+private:
+  /// The memory budget in bytes (zero if disabled)
+  std::size_t memoryBudget = 0U;
+  /// Whether unused chunks are released when the budget is approached
+  bool releaseChunksUnderPressure = false;
+  /// The memory held by the memory managers as accounted for by the budget
+  std::atomic<std::size_t> accountedManagerBytes{0U};
+  /// The memory held by the tables when the accounting was last synchronized
+  std::size_t accountedTableBytes = 0U;
+  /// Whether a parallel operation is running
+  bool parallelOperationRunning = false;
+
+  /**
+   * @brief Marks the scope of a parallel operation
+   * @details Synchronizes the memory accounting on entry, so that allocations
+   * of the worker threads can be accounted for without reading the statistics
+   * of the memory managers. Nested scopes have no effect.
+   */
+  class ParallelOperationScope {
+  public:
+    explicit ParallelOperationScope(Package& package)
+        : pkg(&package), nested(package.parallelOperationRunning) {
+      if (!nested) {
+        pkg->synchronizeMemoryAccounting();
+        pkg->parallelOperationRunning = true;
+      }
+    }
+    ~ParallelOperationScope() {
+      if (!nested) {
+        pkg->parallelOperationRunning = false;
+      }
+    }
+    ParallelOperationScope(const ParallelOperationScope&) = delete;
+    ParallelOperationScope& operator=(const ParallelOperationScope&) = delete;
+    ParallelOperationScope(ParallelOperationScope&&) = delete;
+    ParallelOperationScope& operator=(ParallelOperationScope&&) = delete;
+
+  private:
+    Package* pkg;
+    bool nested;
+  };
+
+  /// Get the memory held by the memory managers in bytes
+  [[nodiscard]] std::size_t getMemoryManagerUsage() const noexcept {
+    const auto managerBytes = [](const auto& manager) {
+      const auto& stats = manager.getStats();
+      return stats.numAllocated * stats.entrySize;
+    };
+    return managerBytes(vMemoryManager) + managerBytes(mMemoryManager) +
+           managerBytes(dMemoryManager) + managerBytes(cMemoryManager);
+  }
+
+  /// Synchronize the accounted memory with the actual usage
+  void synchronizeMemoryAccounting() noexcept {
+    if (memoryBudget == 0U) {
+      return;
+    }
+    const auto managerBytes = getMemoryManagerUsage();
+    accountedManagerBytes = managerBytes;
+    accountedTableBytes = getMemoryUsage() - managerBytes;
+  }
+
+  /**
+   * @brief Account for memory that a memory manager is about to allocate
+   * @details Called by the memory managers (under their respective lock)
+   * before allocating a new chunk. During a parallel operation, several
+   * managers may allocate at the same time. Hence, the statistics of the
+   * other managers must not be read and the allocation is accounted for by
+   * atomically updating the accounted memory instead.
+   * @param additionalBytes The number of bytes that are about to be allocated.
+   * @throws MemoryBudgetExceeded if the budget would be exceeded.
+   */
+  void reserveMemory(const std::size_t additionalBytes) {
+    if (!parallelOperationRunning) {
+      checkMemoryBudget(additionalBytes);
+      return;
+    }
+    auto managerBytes = accountedManagerBytes.load();
+    do {
+      throwIfExceeded(accountedTableBytes + managerBytes, additionalBytes);
+    } while (!accountedManagerBytes.compare_exchange_weak(
+        managerBytes, managerBytes + additionalBytes));
+  }
+
+  /**
+   * @brief Check whether additional memory fits into the budget
+   * @details Must not be called during a parallel operation.
+   * @param additionalBytes The number of bytes that are about to be allocated.
+   * @throws MemoryBudgetExceeded if the budget would be exceeded.
+   */
+  void checkMemoryBudget(const std::size_t additionalBytes) const {
+    throwIfExceeded(getMemoryUsage(), additionalBytes);
+  }
+
+  /// Throw if @p additionalBytes on top of @p usage exceed the budget
+  void throwIfExceeded(const std::size_t usage,
+                       const std::size_t additionalBytes) const {
+    if (usage + additionalBytes > memoryBudget) {
+      throw MemoryBudgetExceeded(
+          "DD package memory budget of " + std::to_string(memoryBudget) +
+          " bytes exceeded: " + std::to_string(usage) +
+          " bytes are in use and another " + std::to_string(additionalBytes) +
+          " bytes were requested. Consider increasing the budget or releasing "
+          "references to DDs that are no longer needed.");
+    }
+  }
+
+  /**
+   * @brief Free as much memory as possible after a full garbage collection
+   * @throws MemoryBudgetExceeded if the remaining working set does not fit
+   * into the budget.
+   */
+  void enforceMemoryBudget() {
+    clearComputeTables();
+    applyToComputeTables([](auto& table) { table.shrinkToInitialSize(); });
+    if (releaseChunksUnderPressure) {
+      vMemoryManager.releaseUnusedChunks();
+      mMemoryManager.releaseUnusedChunks();
+      dMemoryManager.releaseUnusedChunks();
+      cMemoryManager.releaseUnusedChunks();
+    }
+    checkMemoryBudget(0U);
+  }
+
+public:
+  ///
+  /// Memory compaction
+  ///
+
+  /**
+   * @brief Compact the memory held by the package
+   * @details Over the course of a long computation, garbage collection leaves
+   * the chunks of the memory managers sparsely populated and the lists of
+   * available entries interleave entries from all chunks. Compaction performs
+   * a full garbage collection and then relocates all remaining nodes and
+   * numbers into one dense chunk per memory manager (see
+   * MemoryManager::compact). All other chunks are freed. The unique tables are
+   * rebuilt and the edges of all nodes are updated accordingly. The compute
+   * tables and the gate cache are cleared. Compaction must only be performed
+   * between operations.
+   * @note Edges held outside the package refer to the previous addresses of
+   * their nodes and weights. Hence, all DDs that are still needed have to be
+   * referenced (see incRef) and passed as @p roots, which are updated in place.
+   * All other edges obtained from the package become invalid.
+   * @param roots The root edges of the DDs to keep.
+   * @returns The number of bytes freed by the memory managers.
+   */
+  template <class... Nodes> std::size_t compactMemory(Edge<Nodes>&... roots) {
+    clearGateCache();
+    clearComputeTables();
+    garbageCollect(true);
+
+    const auto reclaimedBefore = getReclaimedBytes();
+    MemoryRelocation relocation{};
+    relocation.numbers = cMemoryManager.compact();
+    cUniqueTable.relocate(relocation.numbers);
+    relocateNodes<vNode>(relocation, relocation.vNodes);
+    relocateNodes<mNode>(relocation, relocation.mNodes);
+    relocateNodes<dNode>(relocation, relocation.dNodes);
+    (relocation.apply(roots), ...);
+    return getReclaimedBytes() - reclaimedBefore;
+  }
+
+private:
+  /// The relocations established by compacting the memory managers
+  struct MemoryRelocation {
+    Relocation<RealNumber> numbers;
+    Relocation<vNode> vNodes;
+    Relocation<mNode> mNodes;
+    Relocation<dNode> dNodes;
+
+    /**
+     * @brief Get the new address of a pointer
+     * @details Pointers to numbers and density matrix nodes carry flags in
+     * their lowest bits, which are preserved. Pointers that have not been
+     * relocated (e.g., terminals and constants) are returned unchanged.
+     */
+    template <class T>
+    [[nodiscard]] static T* relocated(T* p, const Relocation<T>& relocation) {
+      constexpr std::uintptr_t flagMask = alignof(T) - 1U;
+      const auto address = reinterpret_cast<std::uintptr_t>(p);
+      const auto it =
+          relocation.find(reinterpret_cast<const T*>(address & ~flagMask));
+      if (it == relocation.end()) {
+        return p;
+      }
+      return reinterpret_cast<T*>(
+          reinterpret_cast<std::uintptr_t>(it->second) | (address & flagMask));
+    }
+
+    /// Update the node and the weight of an edge
+    template <class Node> void apply(Edge<Node>& e) const {
+      if constexpr (std::is_same_v<Node, vNode>) {
+        e.p = relocated(e.p, vNodes);
+      } else if constexpr (std::is_same_v<Node, mNode>) {
+        e.p = relocated(e.p, mNodes);
+      } else {
+        e.p = relocated(e.p, dNodes);
+      }
+      e.w.r = relocated(e.w.r, numbers);
+      e.w.i = relocated(e.w.i, numbers);
+    }
+  };
+
+  /// Compact the nodes of a type and update their unique table
+  template <class Node>
+  void relocateNodes(const MemoryRelocation& relocation,
+                     Relocation<Node>& nodes) {
+    nodes = getMemoryManager<Node>().compact();
+    getUniqueTable<Node>().relocate(nodes, [&relocation](Node* p) {
+      for (auto& e : p->e) {
+        relocation.apply(e);
+      }
+    });
+  }
+
+  /// Get the total number of bytes reclaimed by the memory managers
+  [[nodiscard]] std::size_t getReclaimedBytes() const noexcept {
+    return vMemoryManager.getStats().reclaimedBytes +
+           mMemoryManager.getStats().reclaimedBytes +
+           dMemoryManager.getStats().reclaimedBytes +
+           cMemoryManager.getStats().reclaimedBytes;
+  }
+
+public:
   ///
   /// Vector nodes, edges and quantum states
   ///
@@ -539,8 +1063,14 @@ public:
       em[i] = mEdge::terminal(cn.lookup(mat[i]));
     }
 
+    // the gate acts as the identity on all lines below its lowest qubit
+    const auto lowest = controls.empty()
+                            ? target
+                            : std::min(target, controls.begin()->qubit);
+    extendByIdentity(em, start, lowest);
+
     // process lines below target
-    auto z = static_cast<Qubit>(start);
+    auto z = static_cast<Qubit>(std::max<std::size_t>(start, lowest));
     for (; z < static_cast<Qubit>(target); ++z) {
       for (auto i1 = 0U; i1 < RADIX; ++i1) {
         for (auto i2 = 0U; i2 < RADIX; ++i2) {
@@ -653,10 +1183,18 @@ public:
       }
     }
 
-    // process lines below smaller target
+    // the gate acts as the identity on all lines below its lowest qubit
     auto it = controls.begin();
-    auto z = static_cast<Qubit>(start);
     const auto smallerTarget = std::min(target0, target1);
+    const auto lowest = controls.empty()
+                            ? smallerTarget
+                            : std::min(smallerTarget, controls.begin()->qubit);
+    for (auto& emRow : em) {
+      extendByIdentity(emRow, start, lowest);
+    }
+
+    // process lines below smaller target
+    auto z = static_cast<Qubit>(std::max<std::size_t>(start, lowest));
     for (; z < smallerTarget; ++z) {
       for (auto row = 0U; row < NEDGE; ++row) {
         for (auto col = 0U; col < NEDGE; ++col) {
@@ -773,6 +1311,26 @@ public:
   }
 
 private:
+  /**
+   * @brief Extend the (terminal) entries of a gate matrix by the identity
+   * @details Replaces every non-zero entry by the identity on the lines from
+   * @p start up to (excluding) @p level with the same weight. The identity is
+   * served from the identity table, so that lines a gate does not act on below
+   * its lowest qubit do not require any node construction.
+   */
+  void extendByIdentity(std::array<mEdge, NEDGE>& entries,
+                        const std::size_t start, const std::size_t level) {
+    if (level <= start) {
+      return;
+    }
+    const auto ident = makeIdent(start, level - 1U);
+    for (auto& entry : entries) {
+      if (!entry.w.exactlyZero()) {
+        entry = {ident.p, entry.w};
+      }
+    }
+  }
+
   // check whether node represents a symmetric matrix or the identity
   void checkSpecialMatrices(mNode* p) {
     if (mNode::isTerminal(p)) {
@@ -881,60 +1439,161 @@ public:
 
     auto e = EdgeType<Node>::normalize(p, edges, memoryManager, cn);
 
+    // set specific node properties for matrices. This happens before the node
+    // is published in the unique table so that concurrent readers never
+    // observe a node with incomplete flags.
+    if constexpr (std::is_same_v<Node, mNode>) {
+      checkSpecialMatrices(e.p);
+    }
+
     // look it up in the unique tables
     auto& uniqueTable = getUniqueTable<Node>();
     auto* l = uniqueTable.lookup(e.p);
-
-    // set specific node properties for matrices
-    if constexpr (std::is_same_v<Node, mNode>) {
-      if (l == e.p) {
-        checkSpecialMatrices(l);
-      }
-    }
     return EdgeType<Node>{l, e.w};
   }
 
   template <class Node>
   Edge<Node> deleteEdge(const Edge<Node>& e, const Qubit v,
                         const std::size_t edgeIdx) {
-    std::unordered_map<Node*, Edge<Node>> nodes{};
-    return deleteEdge(e, v, edgeIdx, nodes);
+    constexpr std::size_t n = std::tuple_size_v<decltype(e.p->e)>;
+    std::unordered_map<const Node*, Edge<Node>> nodes{};
+    const auto lookup = [this, &nodes](const Edge<Node>& edge) {
+      if (edge.isTerminal()) {
+        return edge;
+      }
+      auto r = nodes.at(edge.p);
+      r.w = cn.lookup(r.w * edge.w);
+      return r;
+    };
+
+    VisitedSet<Node> visited{};
+    traversePostOrder(
+        static_cast<const Node*>(e.p), visited,
+        [&](const Node* p) {
+          std::array<Edge<Node>, n> edges{};
+          for (std::size_t i = 0; i < n; i++) {
+            if (p->v == v) {
+              // optimization -> node cannot occur below again, since dd is
+              // assumed to be free
+              edges[i] = i == edgeIdx ? Edge<Node>::zero() : p->e[i];
+            } else {
+              edges[i] = lookup(p->e[i]);
+            }
+          }
+          nodes.emplace(p, makeDDNode(p->v, edges));
+        },
+        // successors of nodes at the deleted level are kept as they are
+        [v](const Node* p) { return p->v != v; });
+    return lookup(e);
   }
 
-private:
-  template <class Node>
-  Edge<Node> deleteEdge(const Edge<Node>& e, const Qubit v,
-                        const std::size_t edgeIdx,
-                        std::unordered_map<Node*, Edge<Node>>& nodes) {
-    if (e.isTerminal()) {
-      return e;
-    }
+  ///
+  /// Approximation
+  ///
 
-    const auto& nodeIt = nodes.find(e.p);
-    Edge<Node> r{};
-    if (nodeIt != nodes.end()) {
-      r = nodeIt->second;
-    } else {
-      constexpr std::size_t n = std::tuple_size_v<decltype(e.p->e)>;
-      std::array<Edge<Node>, n> edges{};
-      if (e.p->v == v) {
-        for (std::size_t i = 0; i < n; i++) {
-          edges[i] = i == edgeIdx
-                         ? Edge<Node>::zero()
-                         : e.p->e[i]; // optimization -> node cannot occur below
-                                      // again, since dd is assumed to be free
+  /**
+   * @brief Approximate a state by removing edges with a low contribution
+   * @details The contribution of an edge is the probability mass of all basis
+   * states whose paths pass through it, i.e., the probability of reaching its
+   * source node from the root times the squared magnitude of its weight times
+   * the probability mass below its successor (see assignProbabilities). Edges
+   * are removed in the order of increasing contribution as long as their
+   * accumulated contribution does not exceed `1 - fidelity`. The resulting
+   * state is renormalized to the norm of the original state. Since removing
+   * edges projects the state onto a subset of the basis states, the fidelity
+   * between the original and the approximated state equals the probability
+   * mass that has been retained.
+   * @param e The state to approximate.
+   * @param fidelity The minimum fidelity of the approximation with respect to
+   * @p e.
+   * @returns The approximated state and its actual fidelity with respect to
+   * @p e.
+   */
+  std::pair<vEdge, fp> approximate(const vEdge& e, const fp fidelity) {
+    std::unordered_map<const vNode*, fp> probs{};
+    const auto total = assignProbabilities(e, probs);
+    if (e.isTerminal() || total <= 0. || fidelity >= 1.) {
+      return {e, 1.};
+    }
+
+    // nodes in reverse topological order (successors first)
+    std::vector<const vNode*> nodes{};
+    VisitedSet<vNode> visited{};
+    traversePostOrder(static_cast<const vNode*>(e.p), visited,
+                      [&nodes](const vNode* p) { nodes.emplace_back(p); });
+
+    // distribute the probability of reaching each node from the root
+    struct Contribution {
+      fp mass;
+      const vNode* node;
+      std::size_t edge;
+    };
+    std::vector<Contribution> contributions{};
+    std::unordered_map<const vNode*, fp> reach{};
+    reach.emplace(e.p, ComplexNumbers::mag2(e.w) / total);
+    for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+      const auto* p = *it;
+      const auto mass = reach[p];
+      for (std::size_t i = 0U; i < RADIX; ++i) {
+        const auto& s = p->e[i];
+        if (s.w.exactlyZero()) {
+          continue;
         }
-      } else {
-        for (std::size_t i = 0; i < n; i++) {
-          edges[i] = deleteEdge(e.p->e[i], v, edgeIdx, nodes);
+        const auto edgeMass = mass * ComplexNumbers::mag2(s.w);
+        contributions.push_back({edgeMass * probs.at(s.p), p, i});
+        if (!s.isTerminal()) {
+          reach[s.p] += edgeMass;
         }
       }
+    }
+
+    // remove the least contributing edges within the budget
+    std::sort(contributions.begin(), contributions.end(),
+              [](const Contribution& lhs, const Contribution& rhs) {
+                return lhs.mass < rhs.mass;
+              });
+    std::unordered_map<const vNode*, std::array<bool, RADIX>> removed{};
+    fp removedMass = 0.;
+    for (const auto& [mass, node, edge] : contributions) {
+      if (removedMass + mass > 1. - fidelity) {
+        break;
+      }
+      removedMass += mass;
+      removed[node][edge] = true;
+    }
+    if (removed.empty()) {
+      return {e, 1.};
+    }
 
-      r = makeDDNode(e.p->v, edges);
-      nodes[e.p] = r;
+    // rebuild the DD without the removed edges
+    std::unordered_map<const vNode*, vEdge> rebuilt{};
+    const auto lookup = [this, &rebuilt](const vEdge& edge) {
+      if (edge.isTerminal()) {
+        return edge;
+      }
+      auto r = rebuilt.at(edge.p);
+      r.w = cn.lookup(r.w * edge.w);
+      return r;
+    };
+    for (const auto* p : nodes) {
+      const auto it = removed.find(p);
+      std::array<vEdge, RADIX> edges{};
+      for (std::size_t i = 0U; i < RADIX; ++i) {
+        edges[i] = it != removed.end() && it->second[i] ? vEdge::zero()
+                                                        : lookup(p->e[i]);
+      }
+      rebuilt.emplace(p, makeDDNode(p->v, edges));
     }
-    r.w = cn.lookup(r.w * e.w);
-    return r;
+    auto result = lookup(e);
+    if (result.w.exactlyZero()) {
+      return {e, 1.};
+    }
+
+    // the retained probability mass is the fidelity of the approximation
+    std::unordered_map<const vNode*, fp> resultProbs{};
+    const auto retained = assignProbabilities(result, resultProbs);
+    result.w = cn.lookup(result.w * std::sqrt(total / retained));
+    return {result, retained / total};
   }
 
   ///
@@ -950,6 +1609,8 @@ public:
     vectorInnerProduct.clear();
     vectorKronecker.clear();
     matrixKronecker.clear();
+    matrixTrace.clear();
+    matrixIdentity.clear();
 
     clearIdentityTable();
 
@@ -959,6 +1620,82 @@ public:
     densityNoise.clear();
   }
 
+  /**
+   * @brief Resize all binary compute tables
+   * @details Sets the number of buckets of the addition, multiplication,
+   * Kronecker product and inner product compute tables. Existing entries are
+   * rehashed. This must only be called between operations.
+   * @param numBuckets The new number of buckets (has to be a power of two).
+   */
+  void resizeComputeTables(const std::size_t numBuckets) {
+    applyToComputeTables(
+        [numBuckets](auto& table) { table.resize(numBuckets); });
+  }
+
+  /**
+   * @brief Set the number of buckets compute tables may automatically grow to
+   * @details If set to a non-zero value, the binary compute tables are grown
+   * (doubled) between operations, i.e., whenever `garbageCollect` is invoked,
+   * as soon as their load factor indicates that they are saturated. A value of
+   * zero (the default) disables the automatic growth.
+   * @param maxBuckets The maximum number of buckets per compute table.
+   */
+  void setComputeTableSizeLimit(const std::size_t maxBuckets) noexcept {
+    computeTableSizeLimit = maxBuckets;
+  }
+
+  /// Get the number of buckets compute tables may automatically grow to
+  [[nodiscard]] std::size_t getComputeTableSizeLimit() const noexcept {
+    return computeTableSizeLimit;
+  }
+
+  /**
+   * @brief Grow all saturated binary compute tables up to the size limit
+   * @returns Whether any table was grown.
+   * @see setComputeTableSizeLimit
+   */
+  bool growComputeTables() {
+    bool grown = false;
+    applyToComputeTables([this, &grown](auto& table) {
+      grown |= table.growIfNeeded(computeTableSizeLimit);
+    });
+    return grown;
+  }
+
+private:
+  /// The maximum number of buckets compute tables may automatically grow to
+  std::size_t computeTableSizeLimit = 0U;
+
+  /// Apply a function to all binary compute tables
+  template <class F> void applyToComputeTables(F&& f) {
+    f(vectorAdd);
+    f(matrixAdd);
+    f(densityAdd);
+    f(matrixVectorMultiplication);
+    f(matrixMatrixMultiplication);
+    f(densityDensityMultiplication);
+    f(vectorInnerProduct);
+    f(vectorKronecker);
+    f(matrixKronecker);
+    f(matrixTrace);
+    f(matrixIdentity);
+  }
+  /// Apply a function to all binary compute tables (read-only)
+  template <class F> void applyToComputeTables(F&& f) const {
+    f(vectorAdd);
+    f(matrixAdd);
+    f(densityAdd);
+    f(matrixVectorMultiplication);
+    f(matrixMatrixMultiplication);
+    f(densityDensityMultiplication);
+    f(vectorInnerProduct);
+    f(vectorKronecker);
+    f(matrixKronecker);
+    f(matrixTrace);
+    f(matrixIdentity);
+  }
+
+public:
   ///
   /// Measurements from state decision diagrams
   ///
@@ -1026,33 +1763,187 @@ public:
     return std::string{result.rbegin(), result.rend()};
   }
 
-private:
-  fp assignProbabilities(const vEdge& edge,
-                         std::unordered_map<const vNode*, fp>& probs) {
-    auto it = probs.find(edge.p);
-    if (it != probs.end()) {
-      return ComplexNumbers::mag2(edge.w) * it->second;
+  /**
+   * @brief Sample all qubits of a state multiple times
+   * @details Produces the same distribution as calling `measureAll` (without
+   * collapsing) @p shots times, but is considerably faster for large numbers
+   * of shots. First, the branching probability of every node is computed once
+   * in an annotation pass over the DD. Then, @p shots uniform random numbers
+   * are drawn and sorted. A single descent through the DD partitions the
+   * sorted numbers according to the branching probabilities, such that every
+   * path to a sampled outcome is traversed only once. Overall, the runtime is
+   * linear in the size of the DD and the number of shots (plus the sorting of
+   * the random numbers) instead of proportional to the number of shots times
+   * the number of qubits.
+   * @param rootEdge The state to sample from.
+   * @param shots The number of samples to draw.
+   * @param mt The random number generator.
+   * @param epsilon The tolerance for the normalization of the state.
+   * @returns A map from the sampled outcomes to their counts. The outcomes are
+   * strings of the form "q(n-1) ... q(0)" (see `measureAll`).
+   */
+  std::map<std::string, std::size_t> sampleAll(const vEdge& rootEdge,
+                                               const std::size_t shots,
+                                               std::mt19937_64& mt,
+                                               const fp epsilon = 0.001) {
+    if (std::abs(ComplexNumbers::mag2(rootEdge.w) - 1.0) > epsilon) {
+      if (rootEdge.w.approximatelyZero()) {
+        throw std::runtime_error(
+            "Numerical instabilities led to a 0-vector! Abort simulation!");
+      }
+      std::cerr << "WARNING in sampleAll: numerical instability occurred "
+                   "during simulation: |alpha|^2 + |beta|^2 = "
+                << ComplexNumbers::mag2(rootEdge.w) << ", but should be 1!\n";
     }
-    double sum{1};
-    if (!edge.isTerminal()) {
-      sum = assignProbabilities(edge.p->e[0], probs) +
-            assignProbabilities(edge.p->e[1], probs);
+
+    std::map<std::string, std::size_t> counts{};
+    if (shots == 0U) {
+      return counts;
+    }
+    if (rootEdge.isTerminal()) {
+      counts[""] = shots;
+      return counts;
     }
 
-    probs.insert({edge.p, sum});
+    std::unordered_map<const vNode*, fp> branchProbabilities{};
+    assignBranchProbabilities(rootEdge.p, branchProbabilities, epsilon);
+
+    std::uniform_real_distribution<fp> dist(0.0, 1.0L);
+    std::vector<fp> randoms(shots);
+    for (auto& r : randoms) {
+      r = dist(mt);
+    }
+    std::sort(randoms.begin(), randoms.end());
 
-    return ComplexNumbers::mag2(edge.w) * sum;
+    const auto numberOfQubits = static_cast<std::size_t>(rootEdge.p->v) + 1U;
+    std::string outcome(numberOfQubits, '0');
+    sampleSorted(rootEdge.p, randoms, branchProbabilities, outcome, counts);
+    return counts;
   }
 
-public:
-  std::pair<dd::fp, dd::fp>
-  determineMeasurementProbabilities(const vEdge& rootEdge, const Qubit index,
-                                    const bool assumeProbabilityNormalization) {
-    std::map<const vNode*, fp> probsMone;
-    std::set<const vNode*> visited;
-    std::queue<const vNode*> q;
+private:
+  /**
+   * @brief Compute the probability of taking the 0-successor for every node
+   * @details The nodes are visited iteratively (see traversePostOrder), so
+   * that the depth of the DD is not limited by the size of the call stack.
+   * @param p The node to start from.
+   * @param probs The map to store the probabilities in.
+   * @param epsilon The tolerance for the normalization of the nodes.
+   */
+  static void
+  assignBranchProbabilities(const vNode* p,
+                            std::unordered_map<const vNode*, fp>& probs,
+                            const fp epsilon) {
+    VisitedSet<vNode> visited{};
+    traversePostOrder(p, visited, [&probs, epsilon](const vNode* node) {
+      const fp p0 = ComplexNumbers::mag2(node->e[0].w);
+      const fp p1 = ComplexNumbers::mag2(node->e[1].w);
+      const fp tmp = p0 + p1;
+      if (std::abs(tmp - 1.0) > epsilon) {
+        throw std::runtime_error("Added probabilities differ from 1 by " +
+                                 std::to_string(std::abs(tmp - 1.0)));
+      }
+      probs.emplace(node, p0 / tmp);
+    });
+  }
 
-    probsMone[rootEdge.p] = ComplexNumbers::mag2(rootEdge.w);
+  /**
+   * @brief Distribute sorted random numbers along the paths of a DD
+   * @details Every node corresponds to an interval of [0, 1). Starting with
+   * the whole interval at @p root, the interval of a node is split according
+   * to its branching probability and the random numbers falling into either
+   * subinterval are passed on to the respective successor. The nodes are
+   * visited depth-first with an explicit stack, so that the depth of the DD is
+   * not limited by the size of the call stack.
+   * @param root The root node of the DD.
+   * @param randoms The sorted random numbers.
+   * @param probs The branching probabilities of the nodes.
+   * @param outcome The buffer for the outcome of the current path. Its size
+   * determines the number of qubits.
+   * @param counts The map to store the sampled outcomes in.
+   */
+  static void sampleSorted(const vNode* root, const std::vector<fp>& randoms,
+                           const std::unordered_map<const vNode*, fp>& probs,
+                           std::string& outcome,
+                           std::map<std::string, std::size_t>& counts) {
+    /// A node together with the random numbers and the interval assigned to
+    /// it. The outcome of the path up to the node is given by the outcome of
+    /// the path up to its predecessor and the value of the predecessor's qubit.
+    struct Frame {
+      const vNode* p;
+      std::vector<fp>::const_iterator first;
+      std::vector<fp>::const_iterator last;
+      fp lower;
+      fp width;
+      std::size_t level;
+      char value;
+    };
+
+    std::vector<Frame> stack{};
+    stack.push_back({root, randoms.cbegin(), randoms.cend(), 0., 1.,
+                     outcome.size(), '0'});
+    while (!stack.empty()) {
+      const auto [p, first, last, lower, width, level, value] = stack.back();
+      stack.pop_back();
+      if (first == last) {
+        continue;
+      }
+      // the paths sampled since the predecessor was visited only changed the
+      // outcome at its level and below, so the levels above are still intact
+      if (level < outcome.size()) {
+        outcome[level] = value;
+      }
+      if (vNode::isTerminal(p)) {
+        counts[std::string{outcome.rbegin(), outcome.rend()}] +=
+            static_cast<std::size_t>(std::distance(first, last));
+        continue;
+      }
+
+      // successors with a zero weight must never be sampled, regardless of
+      // rounding errors in the interval bounds
+      const auto p0 = probs.at(p);
+      const auto split = lower + (width * p0);
+      auto mid = first;
+      if (p->e[1].w.exactlyZero()) {
+        mid = last;
+      } else if (!p->e[0].w.exactlyZero()) {
+        mid = std::lower_bound(first, last, split);
+      }
+
+      // the 0-successor is pushed last so that it is processed first
+      const auto v = static_cast<std::size_t>(p->v);
+      stack.push_back({p->e[1].p, mid, last, split, width * (1. - p0), v, '1'});
+      stack.push_back({p->e[0].p, first, mid, lower, width * p0, v, '0'});
+    }
+  }
+
+  fp assignProbabilities(const vEdge& edge,
+                         std::unordered_map<const vNode*, fp>& probs) {
+    probs.emplace(vNode::getTerminal(), 1.);
+    VisitedSet<vNode> visited{};
+    for (const auto& [p, prob] : probs) {
+      visited.emplace(p);
+    }
+    traversePostOrder(static_cast<const vNode*>(edge.p), visited,
+                      [&probs](const vNode* p) {
+                        fp sum{0};
+                        for (const auto& e : p->e) {
+                          sum += ComplexNumbers::mag2(e.w) * probs.at(e.p);
+                        }
+                        probs.emplace(p, sum);
+                      });
+    return ComplexNumbers::mag2(edge.w) * probs.at(edge.p);
+  }
+
+public:
+  std::pair<dd::fp, dd::fp>
+  determineMeasurementProbabilities(const vEdge& rootEdge, const Qubit index,
+                                    const bool assumeProbabilityNormalization) {
+    std::map<const vNode*, fp> probsMone;
+    std::set<const vNode*> visited;
+    std::queue<const vNode*> q;
+
+    probsMone[rootEdge.p] = ComplexNumbers::mag2(rootEdge.w);
     visited.insert(rootEdge.p);
     q.push(rootEdge.p);
 
@@ -1196,12 +2087,13 @@ public:
   /// Addition
   ///
   ComputeTable<vCachedEdge, vCachedEdge, vCachedEdge,
-               Config::CT_VEC_ADD_NBUCKET>
+               Config::CT_VEC_ADD_NBUCKET, Config::CT_NWAYS>
       vectorAdd{};
   ComputeTable<mCachedEdge, mCachedEdge, mCachedEdge,
-               Config::CT_MAT_ADD_NBUCKET>
+               Config::CT_MAT_ADD_NBUCKET, Config::CT_NWAYS>
       matrixAdd{};
-  ComputeTable<dCachedEdge, dCachedEdge, dCachedEdge, Config::CT_DM_ADD_NBUCKET>
+  ComputeTable<dCachedEdge, dCachedEdge, dCachedEdge, Config::CT_DM_ADD_NBUCKET,
+               Config::CT_NWAYS>
       densityAdd{};
 
   template <class Node> [[nodiscard]] auto& getAddComputeTable() {
@@ -1224,6 +2116,13 @@ public:
       var = y.p->v;
     }
 
+    if constexpr (!std::is_same_v<Node, dNode>) {
+      if (isParallelEvaluationEnabled()) {
+        const ParallelOperationScope scope(*this);
+        return cn.lookup(
+            add2Parallel(CachedEdge{x.p, x.w}, {y.p, y.w}, var, 0U));
+      }
+    }
     const auto result = add2(CachedEdge{x.p, x.w}, {y.p, y.w}, var);
     return cn.lookup(result);
   }
@@ -1253,32 +2152,7 @@ public:
     constexpr std::size_t n = std::tuple_size_v<decltype(x.p->e)>;
     std::array<CachedEdge<Node>, n> edge{};
     for (std::size_t i = 0U; i < n; i++) {
-      CachedEdge<Node> e1{};
-      if (!Node::isTerminal(x.p)) {
-        auto& xSuccessor = x.p->e[i];
-        e1 = {xSuccessor.p, 0};
-        if (!xSuccessor.w.exactlyZero()) {
-          e1.w = x.w * xSuccessor.w;
-        }
-      } else {
-        e1 = x;
-        if (y.p->e[i].isTerminal()) {
-          e1 = CachedEdge<Node>::zero();
-        }
-      }
-      CachedEdge<Node> e2{};
-      if (!Node::isTerminal(y.p)) {
-        auto& ySuccessor = y.p->e[i];
-        e2 = {ySuccessor.p, 0};
-        if (!ySuccessor.w.exactlyZero()) {
-          e2.w = y.w * ySuccessor.w;
-        }
-      } else {
-        e2 = y;
-        if (x.p->e[i].isTerminal()) {
-          e2 = CachedEdge<Node>::zero();
-        }
-      }
+      auto [e1, e2] = getAddSuccessors(x, y, i);
 
       if constexpr (std::is_same_v<Node, dNode>) {
         dNode::applyDmChangesToNode(e1.p);
@@ -1295,6 +2169,85 @@ public:
     return r;
   }
 
+  /**
+   * @brief Get the operands of the i-th recursive call of an addition
+   * @details The successors are weighted by the incoming edge weights. If one
+   * of the operands is a terminal, it is passed on as is (unless the
+   * corresponding successor of the other operand is a terminal).
+   */
+  template <class Node>
+  static std::pair<CachedEdge<Node>, CachedEdge<Node>>
+  getAddSuccessors(const CachedEdge<Node>& x, const CachedEdge<Node>& y,
+                   const std::size_t i) {
+    CachedEdge<Node> e1{};
+    if (!Node::isTerminal(x.p)) {
+      auto& xSuccessor = x.p->e[i];
+      e1 = {xSuccessor.p, 0};
+      if (!xSuccessor.w.exactlyZero()) {
+        e1.w = x.w * xSuccessor.w;
+      }
+    } else {
+      e1 = x;
+      if (y.p->e[i].isTerminal()) {
+        e1 = CachedEdge<Node>::zero();
+      }
+    }
+    CachedEdge<Node> e2{};
+    if (!Node::isTerminal(y.p)) {
+      auto& ySuccessor = y.p->e[i];
+      e2 = {ySuccessor.p, 0};
+      if (!ySuccessor.w.exactlyZero()) {
+        e2.w = y.w * ySuccessor.w;
+      }
+    } else {
+      e2 = y;
+      if (x.p->e[i].isTerminal()) {
+        e2 = CachedEdge<Node>::zero();
+      }
+    }
+    return {e1, e2};
+  }
+
+  /**
+   * @brief Parallel version of add2 for vector and matrix DDs
+   * @details The recursive calls of the topmost levels are spawned as tasks on
+   * the thread pool. Once `depth` reaches the configured cutoff, the serial
+   * implementation is used.
+   */
+  template <class Node>
+  CachedEdge<Node> add2Parallel(const CachedEdge<Node>& x,
+                                const CachedEdge<Node>& y, const Qubit var,
+                                const std::size_t depth) {
+    if (depth >= parallelDepthCutoff || x.w.exactlyZero() ||
+        y.w.exactlyZero() || x.p == y.p) {
+      return add2(x, y, var);
+    }
+
+    auto& computeTable = getAddComputeTable<Node>();
+    if (const auto* r = computeTable.lookup(x, y); r != nullptr) {
+      return *r;
+    }
+
+    constexpr std::size_t n = std::tuple_size_v<decltype(x.p->e)>;
+    std::array<std::future<CachedEdge<Node>>, n> tasks{};
+    for (std::size_t i = 0U; i < n; i++) {
+      tasks[i] = threadPool->submit(
+          [this, successors = getAddSuccessors(x, y, i), var, depth]() {
+            const auto& [e1, e2] = successors;
+            return add2Parallel(e1, e2, static_cast<Qubit>(var - 1),
+                                depth + 1U);
+          });
+    }
+    threadPool->waitAll(tasks);
+    std::array<CachedEdge<Node>, n> edge{};
+    for (std::size_t i = 0U; i < n; i++) {
+      edge[i] = tasks[i].get();
+    }
+    auto r = makeDDNode(var, edge);
+    computeTable.insert(x, y, r);
+    return r;
+  }
+
   ///
   /// Matrix (conjugate) transpose
   ///
@@ -1332,11 +2285,14 @@ public:
   ///
   /// Multiplication
   ///
-  ComputeTable<mNode*, vNode*, vCachedEdge, Config::CT_MAT_VEC_MULT_NBUCKET>
+  ComputeTable<mNode*, vNode*, vCachedEdge, Config::CT_MAT_VEC_MULT_NBUCKET,
+               Config::CT_NWAYS>
       matrixVectorMultiplication{};
-  ComputeTable<mNode*, mNode*, mCachedEdge, Config::CT_MAT_MAT_MULT_NBUCKET>
+  ComputeTable<mNode*, mNode*, mCachedEdge, Config::CT_MAT_MAT_MULT_NBUCKET,
+               Config::CT_NWAYS>
       matrixMatrixMultiplication{};
-  ComputeTable<dNode*, dNode*, dCachedEdge, Config::CT_DM_DM_MULT_NBUCKET>
+  ComputeTable<dNode*, dNode*, dCachedEdge, Config::CT_DM_DM_MULT_NBUCKET,
+               Config::CT_NWAYS>
       densityDensityMultiplication{};
 
   template <class RightOperandNode>
@@ -1405,12 +2361,97 @@ public:
       if (!y.isTerminal() && y.p->v > var) {
         var = y.p->v;
       }
+      if constexpr (!std::is_same_v<RightOperandNode, dNode>) {
+        if (isParallelEvaluationEnabled()) {
+          const ParallelOperationScope scope(*this);
+          return cn.lookup(multiply2Parallel(x, y, var, start, 0U));
+        }
+      }
       const auto e = multiply2(x, y, var, start);
       return cn.lookup(e);
     }
   }
 
+  /**
+   * @brief Multiply a gate DD that is implicitly extended by identities
+   * @details The gate DD only has to span the qubits up to the highest qubit
+   * the gate acts on (e.g., as obtained from makeGateDD with a reduced number
+   * of qubits). On all qubits above, it is treated as the identity without
+   * materializing the corresponding nodes. The result is the same as that of
+   * multiplying the gate DD extended to the full width of @p y, but neither
+   * the construction nor the traversal of the gate DD depends on the number of
+   * qubits above the gate. Below the gate, the matrix-vector or matrix-matrix
+   * multiplication is used as is.
+   * @param gate The gate DD.
+   * @param y The vector or matrix DD, which must not be narrower than @p gate.
+   * @returns The product of the extended gate and @p y.
+   */
+  template <class RightOperandNode>
+  Edge<RightOperandNode> multiplyExtended(const mEdge& gate,
+                                          const Edge<RightOperandNode>& y) {
+    static_assert(std::is_same_v<RightOperandNode, vNode> ||
+                      std::is_same_v<RightOperandNode, mNode>,
+                  "Right operand must be a vector or matrix");
+    if (gate.isTerminal()) {
+      const auto w = static_cast<ComplexValue>(gate.w) *
+                     static_cast<ComplexValue>(y.w);
+      return cn.lookup(CachedEdge<RightOperandNode>{y.p, w});
+    }
+    if (y.isTerminal() || y.p->v < gate.p->v) {
+      throw std::invalid_argument(
+          "The gate DD must not be wider than the DD it is applied to.");
+    }
+    return cn.lookup(multiplyExtended2(gate, y));
+  }
+
 private:
+  /**
+   * @brief Recursively pass the levels of @p y above the gate
+   * @details Results are stored in the regular multiplication compute tables.
+   * Their keys cannot clash with those of `multiply2`, where both operands
+   * always reside on the same level.
+   */
+  template <class RightOperandNode>
+  CachedEdge<RightOperandNode>
+  multiplyExtended2(const mEdge& gate, const Edge<RightOperandNode>& y) {
+    if (gate.w.exactlyZero() || y.w.exactlyZero()) {
+      return CachedEdge<RightOperandNode>::zero();
+    }
+    const auto var = y.p->v;
+    if (var == gate.p->v) {
+      if (isParallelEvaluationEnabled()) {
+        const ParallelOperationScope scope(*this);
+        return multiply2Parallel(gate, y, var, 0U, 0U);
+      }
+      return multiply2(gate, y, var);
+    }
+
+    const auto rWeight =
+        static_cast<ComplexValue>(gate.w) * static_cast<ComplexValue>(y.w);
+    if (gate.isIdentity()) {
+      return {y.p, rWeight};
+    }
+    assert(!y.isTerminal());
+
+    auto& computeTable = getMultiplicationComputeTable<RightOperandNode>();
+    if (const auto* r = computeTable.lookup(gate.p, y.p); r != nullptr) {
+      return {r->p, r->w * rWeight};
+    }
+
+    // the identity on the current level distributes the gate to all successors
+    const mEdge unweighted{gate.p, Complex::one()};
+    constexpr std::size_t n = std::tuple_size_v<decltype(y.p->e)>;
+    std::array<CachedEdge<RightOperandNode>, n> edge{};
+    for (std::size_t i = 0U; i < n; ++i) {
+      edge[i] = multiplyExtended2(unweighted, y.p->e[i]);
+    }
+    auto e = makeDDNode(var, edge);
+    computeTable.insert(gate.p, y.p, e);
+
+    e.w = e.w * rWeight;
+    return e;
+  }
+
   template <class LeftOperandNode, class RightOperandNode>
   CachedEdge<RightOperandNode>
   multiply2(const Edge<LeftOperandNode>& x, const Edge<RightOperandNode>& y,
@@ -1518,11 +2559,482 @@ private:
     return e;
   }
 
+  /**
+   * @brief Parallel version of multiply2 for vector and matrix DDs
+   * @details All RADIX x RADIX (or RADIX x RADIX x RADIX for matrices) products
+   * of the successors are spawned as tasks on the thread pool and the results
+   * are summed up once all of them are available. Once `depth` reaches the
+   * configured cutoff, the serial implementation is used.
+   */
+  template <class RightOperandNode>
+  CachedEdge<RightOperandNode>
+  multiply2Parallel(const mEdge& x, const Edge<RightOperandNode>& y,
+                    const Qubit var, const Qubit start,
+                    const std::size_t depth) {
+    using ResultEdge = CachedEdge<RightOperandNode>;
+
+    if (depth >= parallelDepthCutoff || x.w.exactlyZero() ||
+        y.w.exactlyZero() || x.isIdentity()) {
+      return multiply2(x, y, var, start);
+    }
+    if constexpr (std::is_same_v<RightOperandNode, mNode>) {
+      if (y.isIdentity()) {
+        return multiply2(x, y, var, start);
+      }
+    }
+
+    const auto rWeight =
+        static_cast<ComplexValue>(x.w) * static_cast<ComplexValue>(y.w);
+    auto& computeTable = getMultiplicationComputeTable<RightOperandNode>();
+    if (const auto* r = computeTable.lookup(x.p, y.p); r != nullptr) {
+      return {r->p, r->w * rWeight};
+    }
+
+    constexpr std::size_t n = std::tuple_size_v<decltype(y.p->e)>;
+    constexpr std::size_t rows = RADIX;
+    constexpr std::size_t cols = n == NEDGE ? RADIX : 1U;
+    const auto v = static_cast<Qubit>(var - 1);
+
+    std::array<std::future<ResultEdge>, n * rows> tasks{};
+    for (auto i = 0U; i < rows; i++) {
+      for (auto j = 0U; j < cols; j++) {
+        for (auto k = 0U; k < rows; k++) {
+          const auto& e1 = x.p->e[rows * i + k];
+          const auto& e2 = y.p->e[j + cols * k];
+          tasks[(cols * i + j) * rows + k] =
+              threadPool->submit([this, e1, e2, v, start, depth]() {
+                return multiply2Parallel(e1, e2, v, start, depth + 1U);
+              });
+        }
+      }
+    }
+
+    threadPool->waitAll(tasks);
+    std::array<ResultEdge, n> edge{};
+    for (auto idx = 0U; idx < n; idx++) {
+      edge[idx] = ResultEdge::zero();
+      for (auto k = 0U; k < rows; k++) {
+        const auto m = tasks[idx * rows + k].get();
+        if (k == 0 || edge[idx].w.exactlyZero()) {
+          edge[idx] = m;
+        } else if (!m.w.exactlyZero()) {
+          edge[idx] = add2(edge[idx], m, v);
+        }
+      }
+    }
+
+    auto e = makeDDNode(var, edge);
+    computeTable.insert(x.p, y.p, e);
+
+    e.w = e.w * rWeight;
+    return e;
+  }
+
+  ///
+  /// Level-by-level multiplication
+  ///
+public:
+  /// The number of products per task when a level is evaluated in parallel
+  static constexpr std::size_t LEVEL_TASK_GRAIN = 64U;
+
+  /**
+   * @brief Multiply a matrix DD with a vector or matrix DD level by level
+   * @details In contrast to multiply, which evaluates the product depth-first,
+   * the product is evaluated breadth-first ("apply by level"). First, all
+   * distinct products of successor nodes that are required are collected
+   * level by level from the top, deduplicating them per level and resolving
+   * trivial products and compute table hits right away. Afterwards, the
+   * collected products are evaluated in bulk, starting at the lowest level.
+   * This improves locality for wide DDs and, if parallel evaluation is enabled
+   * (see enableParallelEvaluation), the products of each level are evaluated
+   * in parallel. The additions of partial products are still evaluated
+   * depth-first. The result is the same as that of multiply.
+   * @param x The matrix DD.
+   * @param y The vector or matrix DD.
+   * @returns The product of both DDs.
+   */
+  template <class RightOperandNode>
+  Edge<RightOperandNode> multiplyByLevel(const mEdge& x,
+                                         const Edge<RightOperandNode>& y) {
+    static_assert(std::is_same_v<RightOperandNode, vNode> ||
+                      std::is_same_v<RightOperandNode, mNode>,
+                  "Right operand must be a vector or matrix");
+    Qubit var{};
+    if (!x.isTerminal()) {
+      var = x.p->v;
+    }
+    if (!y.isTerminal() && y.p->v > var) {
+      var = y.p->v;
+    }
+    return cn.lookup(multiplyByLevel2(x, y, var));
+  }
+
+private:
+  /// Hash function for pairs of nodes
+  struct NodePairHash {
+    template <class Left, class Right>
+    std::size_t
+    operator()(const std::pair<Left*, Right*>& p) const noexcept {
+      return qc::combineHash(
+          qc::murmur64(reinterpret_cast<std::size_t>(p.first)),
+          qc::murmur64(reinterpret_cast<std::size_t>(p.second)));
+    }
+  };
+
+  /**
+   * @brief The products of nodes on a single level of multiplyByLevel
+   * @details `results` contains all distinct products on the level, while
+   * `pending` lists those that have to be computed (in the order they were
+   * discovered). The results are stored without the weights of the operands.
+   */
+  template <class RightOperandNode> struct MultiplicationLevel {
+    using Key = std::pair<mNode*, RightOperandNode*>;
+    std::vector<Key> pending;
+    std::unordered_map<Key, CachedEdge<RightOperandNode>, NodePairHash>
+        results;
+  };
+
+  /**
+   * @brief Resolve the product of two edges without computing it
+   * @returns The product if it is trivial or has been computed already on the
+   * given level, and std::nullopt otherwise.
+   */
+  template <class RightOperandNode>
+  std::optional<CachedEdge<RightOperandNode>>
+  resolveLevelProduct(const mEdge& x, const Edge<RightOperandNode>& y,
+                      const MultiplicationLevel<RightOperandNode>& level) {
+    if (x.w.exactlyZero() || y.w.exactlyZero()) {
+      return CachedEdge<RightOperandNode>::zero();
+    }
+    const auto rWeight =
+        static_cast<ComplexValue>(x.w) * static_cast<ComplexValue>(y.w);
+    if (x.isIdentity()) {
+      return CachedEdge<RightOperandNode>{y.p, rWeight};
+    }
+    if constexpr (std::is_same_v<RightOperandNode, mNode>) {
+      if (y.isIdentity()) {
+        return CachedEdge<RightOperandNode>{x.p, rWeight};
+      }
+    }
+    if (const auto it = level.results.find({x.p, y.p});
+        it != level.results.end()) {
+      return CachedEdge<RightOperandNode>{it->second.p,
+                                          it->second.w * rWeight};
+    }
+    return std::nullopt;
+  }
+
+  /// Compute the product of two nodes from the products on the level below
+  template <class RightOperandNode>
+  CachedEdge<RightOperandNode>
+  multiplyLevelNodes(const mNode* x, const RightOperandNode* y,
+                     const Qubit var,
+                     const MultiplicationLevel<RightOperandNode>& below) {
+    using ResultEdge = CachedEdge<RightOperandNode>;
+    constexpr std::size_t n = std::tuple_size_v<decltype(y->e)>;
+    constexpr std::size_t rows = RADIX;
+    constexpr std::size_t cols = n == NEDGE ? RADIX : 1U;
+    const auto v = static_cast<Qubit>(var - 1);
+
+    std::array<ResultEdge, n> edge{};
+    for (auto i = 0U; i < rows; i++) {
+      for (auto j = 0U; j < cols; j++) {
+        const auto idx = cols * i + j;
+        edge[idx] = ResultEdge::zero();
+        for (auto k = 0U; k < rows; k++) {
+          // all non-trivial products have been computed on the level below
+          const auto m =
+              *resolveLevelProduct(x->e[rows * i + k], y->e[j + cols * k],
+                                   below);
+          if (k == 0 || edge[idx].w.exactlyZero()) {
+            edge[idx] = m;
+          } else if (!m.w.exactlyZero()) {
+            edge[idx] = add2(edge[idx], m, v);
+          }
+        }
+      }
+    }
+    return makeDDNode(var, edge);
+  }
+
+  template <class RightOperandNode>
+  CachedEdge<RightOperandNode>
+  multiplyByLevel2(const mEdge& x, const Edge<RightOperandNode>& y,
+                   const Qubit var) {
+    using Level = MultiplicationLevel<RightOperandNode>;
+    auto& computeTable = getMultiplicationComputeTable<RightOperandNode>();
+
+    std::vector<Level> levels(static_cast<std::size_t>(var) + 1U);
+    if (const auto r = resolveLevelProduct(x, y, levels[var]); r.has_value()) {
+      return *r;
+    }
+
+    // collect the distinct products level by level from the top
+    const auto schedule = [&computeTable](const mEdge& e1,
+                                          const Edge<RightOperandNode>& e2,
+                                          Level& level) {
+      if (e1.w.exactlyZero() || e2.w.exactlyZero() || e1.isIdentity()) {
+        return;
+      }
+      if constexpr (std::is_same_v<RightOperandNode, mNode>) {
+        if (e2.isIdentity()) {
+          return;
+        }
+      }
+      const typename Level::Key key{e1.p, e2.p};
+      if (level.results.count(key) != 0U) {
+        return;
+      }
+      if (const auto* r = computeTable.lookup(e1.p, e2.p); r != nullptr) {
+        level.results.emplace(key, CachedEdge<RightOperandNode>{r->p, r->w});
+        return;
+      }
+      level.results.emplace(key, CachedEdge<RightOperandNode>::zero());
+      level.pending.emplace_back(key);
+    };
+    constexpr std::size_t n = std::tuple_size_v<decltype(y.p->e)>;
+    constexpr std::size_t rows = RADIX;
+    constexpr std::size_t cols = n == NEDGE ? RADIX : 1U;
+    schedule(x, y, levels[var]);
+    for (auto v = var; v > 0; --v) {
+      for (const auto& [p, q] : levels[v].pending) {
+        for (auto i = 0U; i < rows; i++) {
+          for (auto j = 0U; j < cols; j++) {
+            for (auto k = 0U; k < rows; k++) {
+              schedule(p->e[rows * i + k], q->e[j + cols * k],
+                       levels[v - 1U]);
+            }
+          }
+        }
+      }
+    }
+
+    // evaluate the products in bulk, starting at the lowest level
+    for (std::size_t v = 0U; v < levels.size(); ++v) {
+      auto& level = levels[v];
+      const auto& below = levels[v == 0U ? 0U : v - 1U];
+      const auto var2 = static_cast<Qubit>(v);
+      std::vector<CachedEdge<RightOperandNode>> results(level.pending.size());
+      const auto evaluate = [&](const std::size_t first,
+                                const std::size_t last) {
+        for (auto i = first; i < last; ++i) {
+          const auto& [p, q] = level.pending[i];
+          results[i] = multiplyLevelNodes(p, q, var2, below);
+          computeTable.insert(p, q, results[i]);
+        }
+      };
+
+      if (isParallelEvaluationEnabled() &&
+          level.pending.size() > LEVEL_TASK_GRAIN) {
+        const ParallelOperationScope scope(*this);
+        std::vector<std::future<void>> tasks{};
+        for (std::size_t first = 0U; first < level.pending.size();
+             first += LEVEL_TASK_GRAIN) {
+          const auto last =
+              std::min(first + LEVEL_TASK_GRAIN, level.pending.size());
+          tasks.emplace_back(threadPool->submit(
+              [&evaluate, first, last]() { evaluate(first, last); }));
+        }
+        // the tasks refer to `evaluate`, so all of them have to finish before
+        // a failure is propagated
+        threadPool->waitAll(tasks);
+        for (auto& task : tasks) {
+          task.get();
+        }
+      } else {
+        evaluate(0U, level.pending.size());
+      }
+
+      for (std::size_t i = 0U; i < results.size(); ++i) {
+        level.results[level.pending[i]] = results[i];
+      }
+    }
+
+    return *resolveLevelProduct(x, y, levels[var]);
+  }
+
+  ///
+  /// Matrix-free gate application
+  ///
+public:
+  /**
+   * @brief Apply a (controlled) single-qubit gate to a vector DD
+   * @details In contrast to multiplying with the DD returned by `makeGateDD`,
+   * the gate is applied without constructing any matrix nodes and without
+   * using the matrix-vector multiplication compute table. Levels above the
+   * target are passed through: successors violating a control are kept as
+   * they are, all others are processed recursively. At the target level, the
+   * successors are combined directly according to the gate matrix. Controls
+   * below the target only require scaling the parts of the successors that
+   * satisfy them. Intermediate results are memoized for the duration of the
+   * call only.
+   * @param x The vector DD to apply the gate to.
+   * @param mat The matrix of the gate.
+   * @param target The target qubit of the gate.
+   * @param controls The controls of the gate.
+   * @returns The resulting vector DD.
+   */
+  vEdge applyGate(const vEdge& x, const GateMatrix& mat,
+                  const qc::Qubit target, const qc::Controls& controls = {}) {
+    if (x.w.exactlyZero()) {
+      return vEdge::zero();
+    }
+    if (x.isTerminal() || x.p->v < target) {
+      throw std::invalid_argument("Target qubit " + std::to_string(target) +
+                                  " is not part of the vector DD.");
+    }
+
+    GateApplication app{};
+    app.target = target;
+    app.controls = &controls;
+    app.lowestControl = target;
+    for (const auto& control : controls) {
+      if (control.qubit == target || control.qubit > x.p->v) {
+        throw std::invalid_argument(
+            "Control qubit " + std::to_string(control.qubit) +
+            " is either the target or not part of the vector DD.");
+      }
+      app.lowestControl = std::min(app.lowestControl, control.qubit);
+    }
+    for (std::size_t i = 0U; i < NEDGE; ++i) {
+      app.mat[i] = static_cast<ComplexValue>(mat[i]);
+    }
+
+    const auto r = applyGate2(x.p, app);
+    return cn.lookup(
+        vCachedEdge{r.p, r.w * static_cast<ComplexValue>(x.w)});
+  }
+
+private:
+  /// The state of a single invocation of `applyGate`
+  struct GateApplication {
+    /// The gate matrix
+    std::array<ComplexValue, NEDGE> mat{};
+    /// The target qubit
+    qc::Qubit target{};
+    /// The controls of the gate
+    const qc::Controls* controls{};
+    /// The lowest control qubit (or the target if there is none below it)
+    qc::Qubit lowestControl{};
+    /// Memoized results of applying the gate to a node
+    std::unordered_map<vNode*, vCachedEdge> applied{};
+    /// Memoized results of applying the entries of the gate below the target
+    std::array<std::unordered_map<vNode*, vCachedEdge>, NEDGE> belowTarget{};
+  };
+
+  /// Multiply the weight of an edge by a factor
+  static vCachedEdge scale(const vCachedEdge& e, const ComplexValue& factor) {
+    if (e.w.exactlyZero() || factor.exactlyZero()) {
+      return vCachedEdge::zero();
+    }
+    return {e.p, e.w * factor};
+  }
+
+  /// Apply the gate to the node `p` (above or at the target level)
+  vCachedEdge applyGate2(vNode* p, GateApplication& app) {
+    if (const auto it = app.applied.find(p); it != app.applied.end()) {
+      return it->second;
+    }
+
+    const auto v = p->v;
+    std::array<vCachedEdge, RADIX> edge{};
+    if (v == app.target) {
+      edge = applyAtTarget(p, app);
+    } else {
+      const auto control = app.controls->find(v);
+      for (std::size_t i = 0U; i < RADIX; ++i) {
+        const auto& successor = p->e[i];
+        if (successor.w.exactlyZero()) {
+          edge[i] = vCachedEdge::zero();
+          continue;
+        }
+        assert(!successor.isTerminal());
+        // successors violating a control are not affected by the gate
+        if (control != app.controls->end() &&
+            ((i == 1U) != (control->type == qc::Control::Type::Pos))) {
+          edge[i] = {successor.p, successor.w};
+          continue;
+        }
+        edge[i] = scale(applyGate2(successor.p, app),
+                        static_cast<ComplexValue>(successor.w));
+      }
+    }
+
+    const auto r = makeDDNode(v, edge);
+    app.applied.emplace(p, r);
+    return r;
+  }
+
+  /// Combine the successors of a node at the target level
+  std::array<vCachedEdge, RADIX> applyAtTarget(vNode* p,
+                                               GateApplication& app) {
+    const auto var = static_cast<Qubit>(p->v - 1);
+    // [e0', e1'] = [[G00, G01], [G10, G11]] [e0, e1], where Gij denotes the
+    // part of the gate below the target (see applyBelowTarget)
+    std::array<vCachedEdge, RADIX> edge{};
+    for (std::size_t i = 0U; i < RADIX; ++i) {
+      std::array<vCachedEdge, RADIX> summands{};
+      for (std::size_t j = 0U; j < RADIX; ++j) {
+        const auto& successor = p->e[j];
+        summands[j] =
+            successor.w.exactlyZero()
+                ? vCachedEdge::zero()
+                : scale(applyBelowTarget(successor.p, (RADIX * i) + j, app),
+                        static_cast<ComplexValue>(successor.w));
+      }
+      edge[i] = add2(summands[0], summands[1], var);
+    }
+    return edge;
+  }
+
+  /**
+   * @brief Apply the part of the gate below the target to the node `p`
+   * @details Below the target, the entry `idx` of the gate matrix acts as a
+   * diagonal operator: amplitudes satisfying all controls are scaled by the
+   * entry, all others are kept (diagonal entries) or cleared (off-diagonal
+   * entries). Hence, no additions are necessary.
+   */
+  vCachedEdge applyBelowTarget(vNode* p, const std::size_t idx,
+                               GateApplication& app) {
+    const auto& satisfied = app.mat[idx];
+    if (vNode::isTerminal(p) || p->v < app.lowestControl) {
+      return scale({p, 1.}, satisfied);
+    }
+    auto& memo = app.belowTarget[idx];
+    if (const auto it = memo.find(p); it != memo.end()) {
+      return it->second;
+    }
+
+    const auto violated = (idx == 0U || idx == NEDGE - 1U) ? 1. : 0.;
+    const auto control = app.controls->find(p->v);
+    std::array<vCachedEdge, RADIX> edge{};
+    for (std::size_t i = 0U; i < RADIX; ++i) {
+      const auto& successor = p->e[i];
+      if (successor.w.exactlyZero()) {
+        edge[i] = vCachedEdge::zero();
+      } else if (control != app.controls->end() &&
+                 ((i == 1U) != (control->type == qc::Control::Type::Pos))) {
+        edge[i] = scale({successor.p, successor.w}, violated);
+      } else {
+        edge[i] = scale(applyBelowTarget(successor.p, idx, app),
+                        static_cast<ComplexValue>(successor.w));
+      }
+    }
+
+    auto r = vCachedEdge::zero();
+    if (!edge[0].w.exactlyZero() || !edge[1].w.exactlyZero()) {
+      r = makeDDNode(p->v, edge);
+    }
+    memo.emplace(p, r);
+    return r;
+  }
+
   ///
   /// Inner product, fidelity, expectation value
   ///
 public:
-  ComputeTable<vNode*, vNode*, vCachedEdge, Config::CT_VEC_INNER_PROD_NBUCKET>
+  ComputeTable<vNode*, vNode*, vCachedEdge, Config::CT_VEC_INNER_PROD_NBUCKET,
+               Config::CT_NWAYS>
       vectorInnerProduct{};
 
   /**
@@ -1687,9 +3199,11 @@ public:
   /// Kronecker/tensor product
   ///
 
-  ComputeTable<vNode*, vNode*, vCachedEdge, Config::CT_VEC_KRON_NBUCKET>
+  ComputeTable<vNode*, vNode*, vCachedEdge, Config::CT_VEC_KRON_NBUCKET,
+               Config::CT_NWAYS>
       vectorKronecker{};
-  ComputeTable<mNode*, mNode*, mCachedEdge, Config::CT_MAT_KRON_NBUCKET>
+  ComputeTable<mNode*, mNode*, mCachedEdge, Config::CT_MAT_KRON_NBUCKET,
+               Config::CT_NWAYS>
       matrixKronecker{};
 
   template <class Node> [[nodiscard]] auto& getKroneckerComputeTable() {
@@ -1782,6 +3296,28 @@ private:
   /// (Partial) trace
   ///
 public:
+  /**
+   * @brief The compute table of the (partial) trace
+   * @details Entries map a node and the number of qubits eliminated above it
+   * to the (unweighted) trace of the node. Since the result also depends on
+   * the qubits to eliminate, the table only holds the results for a single
+   * elimination pattern and is cleared whenever a different pattern is used.
+   */
+  ComputeTable<mNode*, std::size_t, mCachedEdge, Config::CT_MAT_TRACE_NBUCKET,
+               Config::CT_NWAYS>
+      matrixTrace{};
+
+  /**
+   * @brief The compute table of the identity check
+   * @details Entries map a node to whether it is close to the identity. The
+   * second operand is unused. The table only holds the results for a single
+   * combination of tolerance, garbage qubits, and `checkCloseToOne` and is
+   * cleared whenever a different combination is used.
+   */
+  ComputeTable<mNode*, std::size_t, bool, Config::CT_MAT_IDENTITY_NBUCKET,
+               Config::CT_NWAYS>
+      matrixIdentity{};
+
   mEdge partialTrace(const mEdge& a, const std::vector<bool>& eliminate) {
     auto r = trace(a, eliminate);
     return cn.lookup(r);
@@ -1806,127 +3342,151 @@ public:
   bool isCloseToIdentity(const mEdge& m, const dd::fp tol = 1e-10,
                          const std::vector<bool>& garbage = {},
                          const bool checkCloseToOne = true) {
-    std::unordered_set<decltype(m.p)> visited{};
-    visited.reserve(mUniqueTable.getNumActiveEntries());
-    return isCloseToIdentityRecursive(m, visited, tol, garbage,
-                                      checkCloseToOne);
+    if (tol != identityTolerance || garbage != identityGarbage ||
+        checkCloseToOne != identityCheckCloseToOne) {
+      matrixIdentity.clear();
+      identityTolerance = tol;
+      identityGarbage = garbage;
+      identityCheckCloseToOne = checkCloseToOne;
+    }
+    return isCloseToIdentityRecursive(m, tol, garbage, checkCloseToOne);
   }
 
 private:
-  /// TODO: introduce a compute table for the trace?
+  /// The elimination pattern the entries of `matrixTrace` belong to
+  std::vector<bool> traceEliminate{};
+  /// The parameters the entries of `matrixIdentity` belong to
+  fp identityTolerance = 0.;
+  std::vector<bool> identityGarbage{};
+  bool identityCheckCloseToOne = false;
+
+  mCachedEdge trace(const mEdge& a, const std::vector<bool>& eliminate) {
+    if (eliminate != traceEliminate) {
+      matrixTrace.clear();
+      traceEliminate = eliminate;
+    }
+    const auto numEliminated = static_cast<std::size_t>(
+        std::count(eliminate.begin(), eliminate.end(), true));
+    return trace(a, eliminate, numEliminated, 0U);
+  }
+
+  /**
+   * @brief Recursively compute the (partial) trace
+   * @param a The matrix DD.
+   * @param eliminate The qubits to eliminate.
+   * @param numEliminated The total number of qubits to eliminate.
+   * @param alreadyEliminated The number of qubits eliminated above `a`.
+   */
   mCachedEdge trace(const mEdge& a, const std::vector<bool>& eliminate,
-                    std::size_t alreadyEliminated = 0) {
+                    const std::size_t numEliminated,
+                    const std::size_t alreadyEliminated) {
     const auto aWeight = static_cast<ComplexValue>(a.w);
     if (aWeight.approximatelyZero()) {
       return mCachedEdge::zero();
     }
 
-    if (mNode::isTerminal(a.p) ||
-        std::none_of(eliminate.begin(), eliminate.end(),
-                     [](bool v) { return v; })) {
+    // nothing is left to eliminate below
+    if (mNode::isTerminal(a.p) || alreadyEliminated == numEliminated) {
       return {a.p, aWeight};
     }
 
+    if (const auto* r = matrixTrace.lookup(a.p, alreadyEliminated);
+        r != nullptr) {
+      return {r->p, r->w * aWeight};
+    }
+
     const auto v = a.p->v;
+    mCachedEdge r{};
     if (eliminate[v]) {
       const auto elims = alreadyEliminated + 1;
-      auto r = add2(trace(a.p->e[0], eliminate, elims),
-                    trace(a.p->e[3], eliminate, elims), v - 1);
-
-      r.w = r.w * aWeight;
-      return r;
-    }
+      r = add2(trace(a.p->e[0], eliminate, numEliminated, elims),
+               trace(a.p->e[3], eliminate, numEliminated, elims), v - 1);
+    } else {
+      std::array<mCachedEdge, NEDGE> edge{};
+      std::transform(a.p->e.cbegin(), a.p->e.cend(), edge.begin(),
+                     [this, &eliminate, numEliminated,
+                      alreadyEliminated](const mEdge& e) -> mCachedEdge {
+                       return trace(e, eliminate, numEliminated,
+                                    alreadyEliminated);
+                     });
+      const auto adjustedV = static_cast<Qubit>(
+          static_cast<std::size_t>(v) - (numEliminated - alreadyEliminated));
+      r = makeDDNode(adjustedV, edge);
+    }
+    matrixTrace.insert(a.p, alreadyEliminated, r);
 
-    std::array<mCachedEdge, NEDGE> edge{};
-    std::transform(
-        a.p->e.cbegin(), a.p->e.cend(), edge.begin(),
-        [this, &eliminate, &alreadyEliminated](const mEdge& e) -> mCachedEdge {
-          return trace(e, eliminate, alreadyEliminated);
-        });
-    const auto adjustedV =
-        static_cast<Qubit>(static_cast<std::size_t>(a.p->v) -
-                           (static_cast<std::size_t>(std::count(
-                                eliminate.begin(), eliminate.end(), true)) -
-                            alreadyEliminated));
-    auto r = makeDDNode(adjustedV, edge);
     r.w = r.w * aWeight;
     return r;
   }
 
-  bool isCloseToIdentityRecursive(const mEdge& m,
-                                  std::unordered_set<decltype(m.p)>& visited,
-                                  const dd::fp tol,
+  bool isCloseToIdentityRecursive(const mEdge& m, const dd::fp tol,
                                   const std::vector<bool>& garbage,
                                   const bool checkCloseToOne) {
-    // immediately return if this node has already been visited
-    if (visited.find(m.p) != visited.end()) {
-      return true;
-    }
-
     // immediately return if this node is identical to the identity
     if (m.isTerminal() || m.p->isIdentity()) {
       return true;
     }
 
-    const auto n = m.p->v;
+    // immediately return if this node has already been checked
+    if (const auto* r = matrixIdentity.lookup(m.p, 0U); r != nullptr) {
+      return *r;
+    }
+
+    const auto result =
+        isCloseToIdentityNode(m.p, tol, garbage, checkCloseToOne);
+    matrixIdentity.insert(m.p, 0U, result);
+    return result;
+  }
+
+  bool isCloseToIdentityNode(const mNode* p, const dd::fp tol,
+                             const std::vector<bool>& garbage,
+                             const bool checkCloseToOne) {
+    const auto n = p->v;
 
     if (garbage.size() > n && garbage[n]) {
-      return isCloseToIdentityRecursive(m.p->e[0U], visited, tol, garbage,
-                                        checkCloseToOne) &&
-             isCloseToIdentityRecursive(m.p->e[1U], visited, tol, garbage,
-                                        checkCloseToOne) &&
-             isCloseToIdentityRecursive(m.p->e[2U], visited, tol, garbage,
-                                        checkCloseToOne) &&
-             isCloseToIdentityRecursive(m.p->e[3U], visited, tol, garbage,
-                                        checkCloseToOne);
-      ;
+      return std::all_of(p->e.begin(), p->e.end(), [&](const mEdge& e) {
+        return isCloseToIdentityRecursive(e, tol, garbage, checkCloseToOne);
+      });
     }
 
     // check whether any of the middle successors is non-zero, i.e., m = [ x 0 0
     // y ]
-    const auto mag1 = dd::ComplexNumbers::mag2(m.p->e[1U].w);
-    const auto mag2 = dd::ComplexNumbers::mag2(m.p->e[2U].w);
+    const auto mag1 = dd::ComplexNumbers::mag2(p->e[1U].w);
+    const auto mag2 = dd::ComplexNumbers::mag2(p->e[2U].w);
     if (mag1 > tol || mag2 > tol) {
       return false;
     }
 
     if (checkCloseToOne) {
       // check whether  m = [ ~1 0 0 y ]
-      const auto mag0 = dd::ComplexNumbers::mag2(m.p->e[0U].w);
+      const auto mag0 = dd::ComplexNumbers::mag2(p->e[0U].w);
       if (std::abs(mag0 - 1.0) > tol) {
         return false;
       }
-      const auto arg0 = dd::ComplexNumbers::arg(m.p->e[0U].w);
+      const auto arg0 = dd::ComplexNumbers::arg(p->e[0U].w);
       if (std::abs(arg0) > tol) {
         return false;
       }
 
       // check whether m = [ x 0 0 ~1 ] or m = [ x 0 0 ~0 ] (the last case is
       // true for an ancillary qubit)
-      const auto mag3 = dd::ComplexNumbers::mag2(m.p->e[3U].w);
+      const auto mag3 = dd::ComplexNumbers::mag2(p->e[3U].w);
       if (mag3 > tol) {
         if (std::abs(mag3 - 1.0) > tol) {
           return false;
         }
-        const auto arg3 = dd::ComplexNumbers::arg(m.p->e[3U].w);
+        const auto arg3 = dd::ComplexNumbers::arg(p->e[3U].w);
         if (std::abs(arg3) > tol) {
           return false;
         }
       }
     }
     // m either has the form [ ~1 0 0 ~1 ] or [ ~1 0 0 ~0 ]
-    const auto ident0 = isCloseToIdentityRecursive(m.p->e[0U], visited, tol,
-                                                   garbage, checkCloseToOne);
-
-    if (!ident0) {
+    if (!isCloseToIdentityRecursive(p->e[0U], tol, garbage, checkCloseToOne)) {
       return false;
     }
     // m either has the form [ I 0 0 ~1 ] or [ I 0 0 ~0 ]
-    const auto ident3 = isCloseToIdentityRecursive(m.p->e[3U], visited, tol,
-                                                   garbage, checkCloseToOne);
-
-    visited.insert(m.p);
-    return ident3;
+    return isCloseToIdentityRecursive(p->e[3U], tol, garbage, checkCloseToOne);
   }
 
 public:
@@ -1993,6 +3553,52 @@ public:
 private:
   std::vector<mEdge> idTable{};
 
+  ///
+  /// Gate DD cache
+  ///
+public:
+  /// The key identifying a gate in the gate cache
+  using GateKey = GateCache<mEdge>::Key;
+
+  /**
+   * @brief Look up the DD of a gate in the gate cache
+   * @param key The key of the gate.
+   * @returns The cached DD of the gate or std::nullopt if it is not cached.
+   */
+  std::optional<mEdge> lookupGateDD(const GateKey& key) {
+    if (const auto* e = gateCache.lookup(key); e != nullptr) {
+      return *e;
+    }
+    return std::nullopt;
+  }
+
+  /**
+   * @brief Store the DD of a gate in the gate cache
+   * @details The cache holds a reference to the DD so that it survives regular
+   * garbage collection. Forced garbage collections release all cached DDs. If
+   * the cache is full, all entries are released first.
+   * @param key The key of the gate.
+   * @param e The DD of the gate.
+   */
+  void cacheGateDD(GateKey key, const mEdge& e) {
+    if (gateCache.full()) {
+      clearGateCache();
+    }
+    if (gateCache.insert(std::move(key), e)) {
+      incRef(e);
+    }
+  }
+
+  /// Release all DDs held by the gate cache and clear it
+  void clearGateCache() {
+    for (const auto& [key, e] : gateCache.getTable()) {
+      decRef(e);
+    }
+    gateCache.clear();
+  }
+
+  GateCache<mEdge> gateCache{};
+
   ///
   /// Noise Operations
   ///
@@ -2203,83 +3809,40 @@ private:
   /// Vector and matrix extraction from DDs
   ///
 public:
-  // transfers a decision diagram from another package to this package
-  template <class Node> Edge<Node> transfer(Edge<Node>& original) {
+  /**
+   * @brief Transfer a decision diagram from another package to this package
+   * @details The nodes are rebuilt bottom-up in post-order, so that every node
+   * is created exactly once and all of its successors are available by then.
+   * The other package must not be modified during the transfer.
+   * @param original The DD in the other package.
+   * @returns The equivalent DD in this package (without a reference).
+   */
+  template <class Node> Edge<Node> transfer(const Edge<Node>& original) {
     if (original.isTerminal()) {
       return {original.p, cn.lookup(original.w)};
     }
 
-    // POST ORDER TRAVERSAL USING ONE STACK
-    // https://www.geeksforgeeks.org/iterative-postorder-traversal-using-stack/
-    Edge<Node> root{};
-    std::stack<Edge<Node>*> stack;
-
-    std::unordered_map<decltype(original.p), decltype(original.p)> mappedNode{};
-
-    Edge<Node>* currentEdge = &original;
-    constexpr std::size_t n = std::tuple_size_v<decltype(original.p->e)>;
-    // NOLINTNEXTLINE(cppcoreguidelines-avoid-do-while)
-    do {
-      while (currentEdge != nullptr && !currentEdge->isTerminal()) {
-        for (std::size_t i = n - 1; i > 0; --i) {
-          auto& edge = currentEdge->p->e[i];
-          if (edge.isTerminal()) {
-            continue;
-          }
-          if (edge.w.approximatelyZero()) {
-            continue;
-          }
-          if (mappedNode.find(edge.p) != mappedNode.end()) {
-            continue;
+    // the edges of this package pointing to the rebuilt nodes
+    std::unordered_map<const Node*, Edge<Node>> mappedNode{};
+    VisitedSet<Node> visited{};
+    traversePostOrder(
+        static_cast<const Node*>(original.p), visited,
+        [this, &mappedNode](const Node* p) {
+          std::array<Edge<Node>, std::tuple_size_v<decltype(p->e)>> edges{};
+          for (std::size_t i = 0U; i < edges.size(); ++i) {
+            const auto& e = p->e[i];
+            if (e.isTerminal()) {
+              edges[i] = {e.p, cn.lookup(e.w)};
+              continue;
+            }
+            const auto& mapped = mappedNode.at(e.p);
+            edges[i] = {mapped.p, cn.lookup(e.w * mapped.w)};
           }
+          mappedNode.emplace(p, makeDDNode(p->v, edges));
+        });
 
-          // non-zero edge to be included
-          stack.push(&edge);
-        }
-        stack.push(currentEdge);
-        currentEdge = &currentEdge->p->e[0];
-      }
-      currentEdge = stack.top();
-      stack.pop();
-
-      bool hasChild = false;
-      for (std::size_t i = 1; i < n && !hasChild; ++i) {
-        auto& edge = currentEdge->p->e[i];
-        if (edge.w.approximatelyZero()) {
-          continue;
-        }
-        if (mappedNode.find(edge.p) != mappedNode.end()) {
-          continue;
-        }
-        hasChild = edge.p == stack.top()->p;
-      }
-
-      if (hasChild) {
-        Edge<Node>* temp = stack.top();
-        stack.pop();
-        stack.push(currentEdge);
-        currentEdge = temp;
-      } else {
-        if (mappedNode.find(currentEdge->p) != mappedNode.end()) {
-          currentEdge = nullptr;
-          continue;
-        }
-        std::array<Edge<Node>, n> edges{};
-        for (std::size_t i = 0; i < n; i++) {
-          if (currentEdge->p->e[i].isTerminal()) {
-            edges[i].p = currentEdge->p->e[i].p;
-          } else {
-            edges[i].p = mappedNode[currentEdge->p->e[i].p];
-          }
-          edges[i].w = cn.lookup(currentEdge->p->e[i].w);
-        }
-        root = makeDDNode(currentEdge->p->v, edges);
-        mappedNode[currentEdge->p] = root.p;
-        currentEdge = nullptr;
-      }
-    } while (!stack.empty());
-    root.w = cn.lookup(original.w * root.w);
-    return root;
+    const auto& root = mappedNode.at(original.p);
+    return {root.p, cn.lookup(original.w * root.w)};
   }
 
   ///
@@ -2408,6 +3971,84 @@ public:
     return deserialize<Node>(ifs, readBinary);
   }
 
+  /**
+   * @brief Import a DD from a snapshot
+   * @details The nodes of a snapshot are stored in topological order and are
+   * already normalized. Hence, they are imported in a single pass without
+   * renormalization. Each distinct weight is only looked up once in the
+   * complex table. Each node is directly looked up in the unique table.
+   * @param snapshot The snapshot to import (see writeSnapshot).
+   * @returns The root edge of the imported DD.
+   * @throws std::runtime_error if the snapshot does not contain a DD of the
+   * requested type or is corrupted.
+   */
+  template <class Node> Edge<Node> importSnapshot(const Snapshot& snapshot) {
+    if (snapshot.kind() != snapshotKind<Node>()) {
+      throw std::runtime_error(
+          "Snapshot does not contain a DD of the requested type.");
+    }
+    constexpr std::size_t n = std::tuple_size_v<decltype(Node::e)>;
+    std::vector<Complex> weights{};
+    weights.reserve(snapshot.numWeights());
+    for (std::size_t i = 0U; i < snapshot.numWeights(); ++i) {
+      weights.emplace_back(cn.lookup(snapshot.weight(i)));
+    }
+    const auto getWeight = [&weights](const std::uint32_t idx) {
+      if (idx >= weights.size()) {
+        throw std::runtime_error("DD refers to an unknown weight.");
+      }
+      return weights[idx];
+    };
+
+    auto& memoryManager = getMemoryManager<Node>();
+    auto& uniqueTable = getUniqueTable<Node>();
+    std::vector<Node*> nodes(snapshot.numNodes());
+    for (std::size_t i = 0U; i < nodes.size(); ++i) {
+      const auto v = snapshot.variable(i);
+      if (v >= nqubits) {
+        throw std::runtime_error(
+            "DD contains a node on qubit " + std::to_string(v) +
+            ", but the package only supports " + std::to_string(nqubits) +
+            " qubits.");
+      }
+      std::array<Edge<Node>, n> edges{};
+      for (std::size_t j = 0U; j < n; ++j) {
+        const auto child = snapshot.child(i, j);
+        if (child != Snapshot::NO_NODE && child >= i) {
+          throw std::runtime_error("DD nodes are not in topological order.");
+        }
+        edges[j] = {child == Snapshot::NO_NODE ? Node::getTerminal()
+                                               : nodes[child],
+                    getWeight(snapshot.weightIndex(i, j))};
+      }
+
+      auto* p = memoryManager.get();
+      p->v = v;
+      p->e = edges;
+      if constexpr (std::is_same_v<Node, mNode>) {
+        p->flags = 0;
+        checkSpecialMatrices(p);
+      }
+      nodes[i] = uniqueTable.lookup(p);
+    }
+
+    const auto root = snapshot.root();
+    return {root == Snapshot::NO_NODE ? Node::getTerminal() : nodes[root],
+            getWeight(snapshot.rootWeight())};
+  }
+
+  /**
+   * @brief Load a DD from a snapshot file
+   * @details The file is memory-mapped and imported via importSnapshot.
+   * @param inputFilename The name of the snapshot file.
+   * @returns The root edge of the loaded DD.
+   */
+  template <class Node>
+  Edge<Node> loadSnapshot(const std::string& inputFilename) {
+    const MappedFile file(inputFilename);
+    return importSnapshot<Node>(Snapshot(file.data(), file.size()));
+  }
+
 private:
   template <class Node, std::size_t N = std::tuple_size_v<decltype(Node::e)>>
   CachedEdge<Node>
@@ -8,6 +8,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <iostream>
+#include <mutex>
 
 namespace dd {
 
@@ -83,6 +84,20 @@ public:
    */
   [[nodiscard]] RealNumber* lookup(fp val);
 
+  /**
+   * @brief Lookup several numbers in the table at once
+   * @details Yields the same entries as calling `lookup` for every number in
+   * order. However, the sign handling, the checks for statically allocated
+   * numbers, and the computation of the bucket keys are performed for all
+   * numbers in separate loops before the first bucket is accessed, and the
+   * table is only locked once if concurrent access is enabled. This is meant
+   * for normalizing all edge weights of a node in one go.
+   * @param vals The floating point numbers to look up.
+   * @param count The number of values to look up.
+   * @param results Receives a pointer to the entry of every number.
+   */
+  void lookup(const fp* vals, std::size_t count, RealNumber** results);
+
   /**
    * @brief Increment the reference count of a number.
    * @details This is a pass-through function that calls the increment function
@@ -126,6 +141,15 @@ public:
    */
   std::size_t garbageCollect(bool force = false) noexcept;
 
+  /**
+   * @brief Update the table after its numbers have been relocated
+   * @details Replaces every number in the table by its new address according
+   * to @p relocation (see MemoryManager::compact). The hash of a number only
+   * depends on its value, so the order of the buckets is preserved.
+   * @param relocation The mapping from previous to new addresses.
+   */
+  void relocate(const Relocation<RealNumber>& relocation);
+
   /**
    * @brief Clear the table.
    * @details This function clears the table. It iterates over all entries in
@@ -134,6 +158,20 @@ public:
    */
   void clear() noexcept;
 
+  /**
+   * @brief Enable or disable concurrent access to the table.
+   * @details If enabled, `lookup` may be called from multiple threads
+   * simultaneously. Lookups are serialized by a single table-wide mutex since
+   * each lookup potentially touches two neighboring buckets as well as the
+   * shared statistics. Reference counting, garbage collection, and clearing
+   * must still not be performed concurrently.
+   * @param enable Whether to enable concurrent access.
+   */
+  void setConcurrent(const bool enable) noexcept { concurrent = enable; }
+
+  /// Check whether concurrent access is enabled
+  [[nodiscard]] bool isConcurrent() const noexcept { return concurrent; }
+
   /**
    * @brief Print the table.
    */
@@ -177,6 +215,11 @@ private:
   /// The current garbage collection limit
   std::size_t gcLimit = initialGCLimit;
 
+  /// Whether concurrent access to the table is enabled
+  bool concurrent = false;
+  /// The mutex guarding lookups if concurrent access is enabled
+  std::mutex mutex;
+
   /**
    * @brief Finds or inserts a value into the bucket indexed by key.
    * @details This function either finds an entry with a value within TOLERANCE
@@ -214,5 +257,17 @@ private:
    * @returns An aligned pointer to the entry corresponding to the number.
    */
   [[nodiscard]] RealNumber* lookupNonNegative(fp val);
+
+  /**
+   * @brief Find or insert a non-negative number given its border keys
+   * @details The second half of `lookupNonNegative`. Must be called with the
+   * table locked (if concurrent access is enabled).
+   * @param val The floating point number to look up. Must be positive.
+   * @param lowerKey The key of `val - RealNumber::eps`.
+   * @param upperKey The key of `val + RealNumber::eps`.
+   * @returns An aligned pointer to the entry corresponding to the number.
+   */
+  [[nodiscard]] RealNumber* lookupNonNegative(fp val, std::int64_t lowerKey,
+                                              std::int64_t upperKey);
 };
 } // namespace dd
@@ -3,25 +3,38 @@
 #include "QuantumComputation.hpp"
 #include "algorithms/GoogleRandomCircuitSampling.hpp"
 #include "dd/Operations.hpp"
+#include "dd/statistics/OperationTrace.hpp"
 
 namespace dd {
 using namespace qc;
 
+/**
+ * @brief Simulate the unitary part of a circuit
+ * @param qc The circuit to simulate.
+ * @param in The input state.
+ * @param dd The package to use.
+ * @param tracer An optional tracer receiving per-operation figures (see
+ * OperationTracer). Tracing is disabled if it is null.
+ * @returns The final state.
+ */
 template <class Config>
 VectorDD simulate(const QuantumComputation* qc, const VectorDD& in,
-                  Package<Config>& dd) {
+                  Package<Config>& dd, OperationTracer* tracer = nullptr) {
   // measurements are currently not supported here
   auto permutation = qc->initialLayout;
   auto e = in;
   dd.incRef(e);
 
+  OperationTraceRecorder trace(tracer, dd);
   for (const auto& op : *qc) {
-    auto tmp = dd.multiply(getDD(op.get(), dd, permutation), e);
+    trace.start(e);
+    auto tmp = applyUnitaryOperation(op.get(), e, dd, permutation);
     dd.incRef(tmp);
     dd.decRef(e);
     e = tmp;
 
     dd.garbageCollect();
+    trace.stop(*op, e);
   }
 
   // correct permutation if necessary
@@ -31,10 +44,130 @@ VectorDD simulate(const QuantumComputation* qc, const VectorDD& in,
   return e;
 }
 
+/**
+ * @brief Simulate a circuit with multiple shots
+ * @details Circuits that are not dynamic are simulated once and sampled
+ * afterwards. Otherwise, every shot is simulated separately.
+ * @param qc The circuit to simulate.
+ * @param in The input state.
+ * @param dd The package to use.
+ * @param shots The number of shots.
+ * @param seed The seed for the random number generator. If zero, a random seed
+ * is used.
+ * @param tracer An optional tracer receiving per-operation figures (see
+ * OperationTracer). Tracing is disabled if it is null.
+ * @returns A map from the classical bits of each shot to their counts.
+ */
 template <class Config>
 std::map<std::string, std::size_t>
 simulate(const QuantumComputation* qc, const VectorDD& in, Package<Config>& dd,
-         std::size_t shots, std::size_t seed = 0U);
+         std::size_t shots, std::size_t seed = 0U,
+         OperationTracer* tracer = nullptr);
+
+/**
+ * @brief Parameters of the approximate simulation
+ * @details Whenever the state exceeds the node threshold after an operation,
+ * it is approximated (see Package::approximate) with the larger of the two
+ * fidelity bounds: the per-step fidelity and the fidelity that is still
+ * permitted by the final fidelity given the fidelity lost so far. Hence, a
+ * per-step fidelity of zero spends the whole remaining budget at once, while
+ * a final fidelity of zero only bounds the individual steps. With the default
+ * values, no approximation is performed.
+ */
+struct ApproximationParameters {
+  /// The number of nodes of the state from which on it is approximated
+  std::size_t nodeThreshold = 1U << 16U;
+  /// The minimum fidelity retained by a single approximation
+  fp stepFidelity = 0.;
+  /// The minimum fidelity of the final state with respect to the exact state
+  fp finalFidelity = 1.;
+};
+
+/// The result of an approximate simulation
+struct ApproximateSimulationResult {
+  /// The (approximated) final state
+  VectorDD state;
+  /// The fidelity of the final state with respect to the exact state
+  fp fidelity = 1.;
+  /// The number of approximations performed
+  std::size_t numApproximations = 0U;
+};
+
+/**
+ * @brief Simulate a circuit approximately
+ * @details Simulates the (unitary part of the) circuit like `simulate`, but
+ * approximates the state whenever it grows beyond the node threshold. The
+ * fidelity lost by subsequent approximations accumulates multiplicatively.
+ * @param qc The circuit to simulate.
+ * @param in The input state.
+ * @param dd The package to use.
+ * @param approximation The parameters of the approximation.
+ * @param tracer An optional tracer receiving per-operation figures (see
+ * OperationTracer). Tracing is disabled if it is null.
+ * @returns The final state together with its fidelity with respect to the
+ * exact final state.
+ */
+template <class Config>
+ApproximateSimulationResult
+simulate(const QuantumComputation* qc, const VectorDD& in, Package<Config>& dd,
+         const ApproximationParameters& approximation,
+         OperationTracer* tracer = nullptr);
+
+/**
+ * @brief Simulate a circuit with multiple shots using multiple threads
+ * @details For dynamic circuits (containing mid-circuit measurements, resets,
+ * or classically-controlled operations), the shots are distributed across
+ * worker threads. Each worker uses its own package with a copy of the input
+ * state (see Package::adoptSettings for the settings taken over from @p dd).
+ * Every fixed-size batch of shots uses a random number generator derived from
+ * the seed. As a consequence, the results are reproducible for a given
+ * (non-zero) seed regardless of the number of threads.
+ * Circuits that are not dynamic are simulated once and sampled afterwards
+ * (see `simulate`).
+ * @param qc The circuit to simulate.
+ * @param in The input state.
+ * @param dd The package the input state belongs to.
+ * @param shots The number of shots.
+ * @param seed The seed for the random number generators. If zero, a random
+ * seed is used.
+ * @param numThreads The number of threads. If zero, the number of hardware
+ * threads is used.
+ * @param tracer An optional tracer receiving per-operation figures (see
+ * OperationTracer). Only supported for circuits that are not dynamic, since
+ * the figures of the worker packages cannot be attributed to single events.
+ * @returns A map from the classical bits of each shot to their counts.
+ * @throws std::invalid_argument If a tracer is given for a dynamic circuit.
+ */
+template <class Config>
+std::map<std::string, std::size_t>
+simulateParallel(const QuantumComputation* qc, const VectorDD& in,
+                 Package<Config>& dd, std::size_t shots, std::size_t seed = 0U,
+                 std::size_t numThreads = 0U,
+                 OperationTracer* tracer = nullptr);
+
+/**
+ * @brief Simulate a dynamic circuit with multiple shots by branching on
+ * measurement outcomes
+ * @details Instead of simulating every shot from the beginning, the circuit is
+ * simulated up to the next mid-circuit measurement (or reset) once for all
+ * shots. There, the shots are split binomially among the (at most two)
+ * outcomes and the simulation continues once per outcome. Hence, the runtime
+ * scales with the number of distinct branches instead of the number of shots.
+ * @param qc The circuit to simulate.
+ * @param in The input state.
+ * @param dd The package to use.
+ * @param shots The number of shots.
+ * @param seed The seed for the random number generator. If zero, a random seed
+ * is used.
+ * @param tracer An optional tracer receiving per-operation figures (see
+ * OperationTracer). Tracing is disabled if it is null.
+ * @returns A map from the classical bits of each shot to their counts.
+ */
+template <class Config>
+std::map<std::string, std::size_t>
+simulateBranching(const QuantumComputation* qc, const VectorDD& in,
+                  Package<Config>& dd, std::size_t shots, std::size_t seed = 0U,
+                  OperationTracer* tracer = nullptr);
 
 template <class Config>
 void extractProbabilityVector(const QuantumComputation* qc, const VectorDD& in,
@@ -51,4 +184,11 @@ template <class Config>
 VectorDD simulate(GoogleRandomCircuitSampling* qc, const VectorDD& in,
                   Package<Config>& dd,
                   std::optional<std::size_t> ncycles = std::nullopt);
+
+/// Simulate a random circuit sampling circuit approximately (see above)
+template <class Config>
+ApproximateSimulationResult
+simulate(GoogleRandomCircuitSampling* qc, const VectorDD& in,
+         Package<Config>& dd, const ApproximationParameters& approximation,
+         std::optional<std::size_t> ncycles = std::nullopt);
 } // namespace dd
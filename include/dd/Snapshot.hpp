@@ -0,0 +1,312 @@
+#pragma once
+
+#include "dd/Complex.hpp"
+#include "dd/ComplexValue.hpp"
+#include "dd/DDDefinitions.hpp"
+#include "dd/Edge.hpp"
+#include "dd/Node.hpp"
+#include "dd/Traversal.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace dd {
+
+///
+/// Snapshots
+/// In contrast to the serialization format (see serialize), snapshots are
+/// portable across platforms. They store a DD in a columnar layout with all
+/// values in little-endian byte order:
+///  - a header of SNAPSHOT_HEADER_SIZE bytes (see Snapshot),
+///  - the variable of each node (16 bit),
+///  - the index of the successor of each edge (32 bit, NO_NODE for terminals),
+///  - the index of the weight of each edge (32 bit),
+///  - the table of distinct weights (real and imaginary part, 64 bit each).
+/// Each column starts at a multiple of eight bytes. Nodes are stored in
+/// topological order, i.e., successors precede their parents, so that a
+/// snapshot can be imported in a single pass (see Package::importSnapshot).
+///
+
+/// The magic bytes at the beginning of every snapshot
+static constexpr std::array<char, 8> SNAPSHOT_MAGIC = {'M', 'Q', 'T', 'D',
+                                                       'D', 'S', 'N', 'P'};
+/// The version of the snapshot format
+static constexpr std::uint32_t SNAPSHOT_VERSION = 1U;
+/// The size of the snapshot header in bytes
+static constexpr std::size_t SNAPSHOT_HEADER_SIZE = 64U;
+
+/// The kind of DD stored in a snapshot
+enum class SnapshotKind : std::uint32_t { Vector = 0U, Matrix = 1U };
+
+/// Get the kind of snapshot corresponding to a node type
+template <class Node> constexpr SnapshotKind snapshotKind() {
+  static_assert(std::is_same_v<Node, vNode> || std::is_same_v<Node, mNode>,
+                "Snapshots are only supported for vector and matrix DDs");
+  if constexpr (std::is_same_v<Node, vNode>) {
+    return SnapshotKind::Vector;
+  } else {
+    return SnapshotKind::Matrix;
+  }
+}
+
+/**
+ * @brief A read-only view of a snapshot stored in memory
+ * @details The view validates the header and the size of the data upon
+ * construction. It does not copy the data, which hence has to outlive the
+ * view. Typically, the data is a memory-mapped file (see MappedFile).
+ */
+class Snapshot {
+public:
+  /// Index of the terminal node
+  static constexpr std::uint32_t NO_NODE =
+      std::numeric_limits<std::uint32_t>::max();
+
+  /**
+   * @brief Construct a view of a snapshot
+   * @param data The snapshot data.
+   * @param size The size of the data in bytes.
+   * @throws std::runtime_error if the data is not a valid snapshot.
+   */
+  Snapshot(const std::byte* data, std::size_t size);
+
+  /// Get the kind of DD stored in the snapshot
+  [[nodiscard]] SnapshotKind kind() const noexcept { return ddKind; }
+
+  /// Get the number of edges per node
+  [[nodiscard]] std::size_t radix() const noexcept { return numEdges; }
+
+  /// Get the number of nodes
+  [[nodiscard]] std::size_t numNodes() const noexcept { return nodes; }
+
+  /// Get the number of distinct weights
+  [[nodiscard]] std::size_t numWeights() const noexcept { return weights; }
+
+  /// Get the index of the root node (or NO_NODE for terminal DDs)
+  [[nodiscard]] std::uint32_t root() const noexcept { return rootNode; }
+
+  /// Get the index of the weight of the root edge
+  [[nodiscard]] std::uint32_t rootWeight() const noexcept {
+    return rootWeightIndex;
+  }
+
+  /// Get the variable of a node
+  [[nodiscard]] Qubit variable(const std::size_t node) const noexcept {
+    return load<Qubit>(variables + (node * sizeof(Qubit)));
+  }
+
+  /// Get the index of the successor of an edge (or NO_NODE for terminals)
+  [[nodiscard]] std::uint32_t child(const std::size_t node,
+                                    const std::size_t edge) const noexcept {
+    return load<std::uint32_t>(children + (((node * numEdges) + edge) *
+                                           sizeof(std::uint32_t)));
+  }
+
+  /// Get the index of the weight of an edge
+  [[nodiscard]] std::uint32_t
+  weightIndex(const std::size_t node, const std::size_t edge) const noexcept {
+    return load<std::uint32_t>(edgeWeights + (((node * numEdges) + edge) *
+                                              sizeof(std::uint32_t)));
+  }
+
+  /// Get a weight from the weight table
+  [[nodiscard]] ComplexValue weight(const std::size_t idx) const noexcept {
+    const auto* entry = weightTable + (idx * 2U * sizeof(std::uint64_t));
+    return {loadDouble(entry), loadDouble(entry + sizeof(std::uint64_t))};
+  }
+
+  /**
+   * @brief Load an unsigned integer stored in little-endian byte order
+   * @details Compilers reduce this to a plain load on little-endian platforms.
+   */
+  template <class T> static T load(const std::byte* data) noexcept {
+    static_assert(std::is_unsigned_v<T>);
+    T value = 0U;
+    for (std::size_t i = 0U; i < sizeof(T); ++i) {
+      value |= static_cast<T>(static_cast<T>(data[i]) << (8U * i));
+    }
+    return value;
+  }
+
+  /// Load a double stored in little-endian byte order
+  static fp loadDouble(const std::byte* data) noexcept {
+    const auto bits = load<std::uint64_t>(data);
+    fp value{};
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+private:
+  SnapshotKind ddKind = SnapshotKind::Vector;
+  std::size_t numEdges = 0U;
+  std::size_t nodes = 0U;
+  std::size_t weights = 0U;
+  std::uint32_t rootNode = NO_NODE;
+  std::uint32_t rootWeightIndex = 0U;
+
+  /// The beginning of the individual columns
+  const std::byte* variables = nullptr;
+  const std::byte* children = nullptr;
+  const std::byte* edgeWeights = nullptr;
+  const std::byte* weightTable = nullptr;
+};
+
+/**
+ * @brief A read-only memory mapping of a file
+ * @details On POSIX systems, the file is mapped into memory via `mmap`, so that
+ * only the pages that are accessed are read from disk. On other platforms, the
+ * file is read into a buffer.
+ */
+class MappedFile {
+public:
+  /**
+   * @brief Map a file into memory
+   * @param filename The name of the file.
+   * @throws std::invalid_argument if the file cannot be opened.
+   */
+  explicit MappedFile(const std::string& filename);
+
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&&) = delete;
+  MappedFile& operator=(MappedFile&&) = delete;
+
+  /// Get the contents of the file
+  [[nodiscard]] const std::byte* data() const noexcept { return contents; }
+
+  /// Get the size of the file in bytes
+  [[nodiscard]] std::size_t size() const noexcept { return length; }
+
+private:
+  const std::byte* contents = nullptr;
+  std::size_t length = 0U;
+  /// The buffer holding the file if it is not memory-mapped
+  std::vector<std::byte> buffer;
+};
+
+/// Append an unsigned integer in little-endian byte order to a buffer
+template <class T>
+void storeLittleEndian(std::vector<char>& buffer, const T value) {
+  static_assert(std::is_unsigned_v<T>);
+  for (std::size_t i = 0U; i < sizeof(T); ++i) {
+    buffer.emplace_back(static_cast<char>((value >> (8U * i)) & 0xFFU));
+  }
+}
+
+/// Pad a buffer with zeros to a multiple of eight bytes
+inline void padSnapshotColumn(std::vector<char>& buffer) {
+  buffer.resize((buffer.size() + 7U) & ~static_cast<std::size_t>(7U), 0);
+}
+
+/**
+ * @brief Write a snapshot of a DD
+ * @details See above for a description of the format. The nodes are collected
+ * in a single iterative post-order traversal and each distinct edge weight is
+ * stored once.
+ * @param basic The root edge of the DD.
+ * @param os The stream to write to.
+ * @throws std::runtime_error if the DD has too many nodes to be indexed by
+ * 32-bit indices.
+ */
+template <class Node>
+void writeSnapshot(const Edge<Node>& basic, std::ostream& os) {
+  constexpr auto kind = snapshotKind<Node>();
+  constexpr std::size_t n = std::tuple_size_v<decltype(Node::e)>;
+
+  std::unordered_map<const Node*, std::uint32_t> nodeIndex{};
+  std::vector<const Node*> nodes{};
+  VisitedSet<Node> visited{};
+  traversePostOrder(basic.p, visited, [&nodes, &nodeIndex](const Node* p) {
+    if (nodes.size() >= Snapshot::NO_NODE) {
+      throw std::runtime_error("DD is too large to be stored in a snapshot.");
+    }
+    nodeIndex.emplace(p, static_cast<std::uint32_t>(nodes.size()));
+    nodes.emplace_back(p);
+  });
+  const auto getNodeIndex = [&nodeIndex](const Node* p) {
+    return Node::isTerminal(p) ? Snapshot::NO_NODE : nodeIndex.at(p);
+  };
+
+  std::unordered_map<ComplexValue, std::uint32_t> weightIndex{};
+  std::vector<ComplexValue> weights{};
+  const auto getWeightIndex = [&weights, &weightIndex](const Complex& c) {
+    const auto value = static_cast<ComplexValue>(c);
+    const auto [it, inserted] = weightIndex.try_emplace(
+        value, static_cast<std::uint32_t>(weights.size()));
+    if (inserted) {
+      weights.emplace_back(value);
+    }
+    return it->second;
+  };
+
+  // the weight indices are determined before the weight table is written
+  std::vector<std::uint32_t> edgeWeights{};
+  edgeWeights.reserve(nodes.size() * n);
+  for (const auto* p : nodes) {
+    for (const auto& s : p->e) {
+      edgeWeights.emplace_back(getWeightIndex(s.w));
+    }
+  }
+  const auto rootWeight = getWeightIndex(basic.w);
+
+  std::vector<char> buffer{};
+  buffer.reserve(SNAPSHOT_HEADER_SIZE +
+                 (nodes.size() * (sizeof(Qubit) + (n * 8U))) +
+                 (weights.size() * 2U * sizeof(std::uint64_t)));
+  buffer.insert(buffer.end(), SNAPSHOT_MAGIC.begin(), SNAPSHOT_MAGIC.end());
+  storeLittleEndian(buffer, SNAPSHOT_VERSION);
+  storeLittleEndian(buffer, static_cast<std::uint32_t>(kind));
+  storeLittleEndian(buffer, static_cast<std::uint32_t>(n));
+  storeLittleEndian(buffer, std::uint32_t{0U});
+  storeLittleEndian<std::uint64_t>(buffer, nodes.size());
+  storeLittleEndian<std::uint64_t>(buffer, weights.size());
+  storeLittleEndian(buffer, getNodeIndex(basic.p));
+  storeLittleEndian(buffer, rootWeight);
+  buffer.resize(SNAPSHOT_HEADER_SIZE, 0);
+
+  for (const auto* p : nodes) {
+    storeLittleEndian(buffer, p->v);
+  }
+  padSnapshotColumn(buffer);
+  for (const auto* p : nodes) {
+    for (const auto& s : p->e) {
+      storeLittleEndian(buffer, getNodeIndex(s.p));
+    }
+  }
+  padSnapshotColumn(buffer);
+  for (const auto idx : edgeWeights) {
+    storeLittleEndian(buffer, idx);
+  }
+  padSnapshotColumn(buffer);
+  for (const auto& w : weights) {
+    std::uint64_t bits{};
+    std::memcpy(&bits, &w.r, sizeof(bits));
+    storeLittleEndian(buffer, bits);
+    std::memcpy(&bits, &w.i, sizeof(bits));
+    storeLittleEndian(buffer, bits);
+  }
+  os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+template <class Node>
+void writeSnapshot(const Edge<Node>& basic, const std::string& outputFilename) {
+  std::ofstream ofs(outputFilename, std::ios::binary);
+  if (!ofs.good()) {
+    throw std::invalid_argument("Cannot open file: " + outputFilename);
+  }
+  writeSnapshot(basic, ofs);
+}
+
+} // namespace dd
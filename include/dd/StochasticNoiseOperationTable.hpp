@@ -56,6 +56,25 @@ public:
     return &entry;
   }
 
+  /**
+   * @brief Invalidate all entries satisfying a predicate
+   * @param predicate The predicate deciding whether an entry is invalidated.
+   * @returns The number of invalidated entries.
+   */
+  template <class Predicate> std::size_t invalidateIf(Predicate&& predicate) {
+    std::size_t invalidated = 0U;
+    for (auto& t : table) {
+      for (auto& entry : t) {
+        if (entry.w.r != nullptr && predicate(entry)) {
+          entry = Edge{};
+          ++invalidated;
+        }
+      }
+    }
+    stats.numEntries -= invalidated;
+    return invalidated;
+  }
+
   void clear() {
     if (stats.numEntries > 0) {
       for (auto& t : table) {
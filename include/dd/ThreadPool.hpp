@@ -0,0 +1,171 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dd {
+
+/**
+ * @brief A work-stealing thread pool for fork-join parallelism.
+ * @details Each worker owns a task queue. Tasks submitted from a worker are
+ * pushed to the back of that worker's queue and are popped from the back again
+ * (LIFO), which keeps the working set of recursive computations local. Idle
+ * workers steal tasks from the front of other queues (FIFO), which tends to
+ * hand out the largest pending subproblems. Tasks submitted from outside of
+ * the pool are placed in a shared queue.
+ * Waiting for the result of a task via `wait` does not block the calling
+ * thread. Instead, it executes pending tasks until the result is available.
+ * This makes it safe to recursively spawn and wait for tasks from within
+ * tasks without exhausting the workers.
+ */
+class ThreadPool {
+public:
+  /**
+   * @brief Construct a new thread pool
+   * @param numThreads The number of worker threads. If zero, the number of
+   * hardware threads is used.
+   */
+  explicit ThreadPool(std::size_t numThreads);
+
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool& operator=(ThreadPool&&) = delete;
+
+  /// Get the number of worker threads
+  [[nodiscard]] std::size_t size() const noexcept { return workers.size(); }
+
+  /**
+   * @brief Submit a task to the pool
+   * @param f The callable to execute.
+   * @returns A future holding the result of the task.
+   */
+  template <class F>
+  [[nodiscard]] auto submit(F&& f) -> std::future<std::invoke_result_t<F>> {
+    using Result = std::invoke_result_t<F>;
+    auto task =
+        std::make_shared<std::packaged_task<Result()>>(std::forward<F>(f));
+    auto future = task->get_future();
+    push([task]() { (*task)(); });
+    return future;
+  }
+
+  /**
+   * @brief Wait for the result of a task while helping to execute others
+   * @param future The future of the task to wait for.
+   * @returns The result of the task.
+   */
+  template <class T> T wait(std::future<T>& future) {
+    waitReady(future);
+    return future.get();
+  }
+
+  /**
+   * @brief Wait for several tasks while helping to execute others
+   * @details Only returns once all tasks have finished, even if some of them
+   * failed with an exception. Results and exceptions are retrieved from the
+   * futures afterwards (e.g., via `get`). This guarantees that no task still
+   * refers to the state of the caller once an exception propagates.
+   * @param futures The futures of the tasks to wait for.
+   */
+  template <class Futures> void waitAll(Futures& futures) {
+    for (auto& future : futures) {
+      waitReady(future);
+    }
+  }
+
+  /**
+   * @brief Call a function for a range of indices in parallel
+   * @details Submits one task per index and waits for all of them (see
+   * waitAll). Afterwards, the first exception thrown by any of the calls (in
+   * the order of the indices) is rethrown.
+   * @param n The number of indices.
+   * @param f The callable to invoke with each index in [0, @p n).
+   */
+  template <class F> void parallelFor(const std::size_t n, F&& f) {
+    std::vector<std::future<void>> tasks{};
+    tasks.reserve(n);
+    for (std::size_t i = 0U; i < n; ++i) {
+      tasks.emplace_back(submit([&f, i]() { f(i); }));
+    }
+    waitAll(tasks);
+    for (auto& task : tasks) {
+      task.get();
+    }
+  }
+
+  /**
+   * @brief Execute a single pending task on the calling thread
+   * @returns Whether a task was executed.
+   */
+  bool runPendingTask();
+
+private:
+  using Task = std::function<void()>;
+
+  /// Execute pending tasks until the given future is ready
+  template <class T> void waitReady(const std::future<T>& future) {
+    while (future.wait_for(std::chrono::seconds(0)) !=
+           std::future_status::ready) {
+      if (!runPendingTask()) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  struct TaskQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  /// Push a task to the queue of the calling worker (or the shared queue)
+  void push(Task task);
+
+  /// Pop a task from the back of the given queue
+  std::optional<Task> popBack(std::size_t idx);
+
+  /// Steal a task from the front of any queue other than the given one
+  std::optional<Task> steal(std::size_t idx);
+
+  /// The main loop executed by each worker
+  void workerLoop(std::size_t idx);
+
+  /// Get the index of the queue associated with the calling thread
+  [[nodiscard]] std::size_t queueIndex() const noexcept;
+
+  /**
+   * @brief The task queues
+   * @details The first `size()` queues belong to the workers, while the last
+   * queue is shared by all threads outside of the pool.
+   */
+  std::vector<std::unique_ptr<TaskQueue>> queues;
+
+  /// The worker threads
+  std::vector<std::thread> workers;
+
+  /// The number of tasks that have been submitted but not yet started
+  std::atomic<std::size_t> numPending{0U};
+
+  /// Whether the pool is shutting down
+  std::atomic<bool> stop{false};
+
+  /// Mutex and condition variable used to put idle workers to sleep
+  std::mutex sleepMutex;
+  std::condition_variable wakeup;
+};
+
+} // namespace dd
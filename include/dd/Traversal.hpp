@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace dd {
+
+/// The set of nodes that have already been visited during a DD traversal
+template <class Node> using VisitedSet = std::unordered_set<const Node*>;
+
+/**
+ * @brief Iteratively visit the nodes of a DD in post-order
+ * @details Every non-terminal node reachable from @p root that is not yet
+ * contained in @p visited is added to it and passed to @p visit exactly once,
+ * after all of its successors have been visited. Successors are traversed in
+ * the order of the node's edges. The traversal uses an explicit stack, so its
+ * depth is not limited by the size of the call stack.
+ * @param root The root node of the DD.
+ * @param visited The set of visited nodes. Nodes contained in it are skipped
+ * together with all their successors.
+ * @param visit The function to call for each visited node.
+ * @param expand A predicate deciding whether the successors of a node are
+ * traversed. Nodes for which it returns false are visited as leaves.
+ */
+template <class Node, class Visitor, class Expand>
+void traversePostOrder(const Node* root, VisitedSet<Node>& visited,
+                       Visitor&& visit, Expand&& expand) {
+  constexpr std::size_t n = std::tuple_size_v<decltype(Node::e)>;
+  if (Node::isTerminal(root) || !visited.emplace(root).second) {
+    return;
+  }
+
+  std::vector<std::pair<const Node*, std::size_t>> stack{};
+  stack.emplace_back(root, expand(root) ? 0U : n);
+  while (!stack.empty()) {
+    auto& [p, next] = stack.back();
+    if (next < n) {
+      const auto* child = p->e[next].p;
+      ++next;
+      // `p` and `next` must not be used after the stack has grown
+      if (!Node::isTerminal(child) && visited.emplace(child).second) {
+        stack.emplace_back(child, expand(child) ? 0U : n);
+      }
+      continue;
+    }
+    visit(p);
+    stack.pop_back();
+  }
+}
+
+/// Iteratively visit all nodes of a DD in post-order (see above)
+template <class Node, class Visitor>
+void traversePostOrder(const Node* root, VisitedSet<Node>& visited,
+                       Visitor&& visit) {
+  traversePostOrder(root, visited, std::forward<Visitor>(visit),
+                    [](const Node*) { return true; });
+}
+
+} // namespace dd
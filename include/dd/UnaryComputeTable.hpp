@@ -69,6 +69,23 @@ public:
     return &entry.result;
   }
 
+  /**
+   * @brief Invalidate all entries satisfying a predicate
+   * @param predicate The predicate deciding whether an entry is invalidated.
+   * @returns The number of invalidated entries.
+   */
+  template <class Predicate> std::size_t invalidateIf(Predicate&& predicate) {
+    std::size_t invalidated = 0U;
+    for (std::size_t key = 0U; key < NBUCKET; ++key) {
+      if (valid[key] && predicate(table[key])) {
+        valid.reset(key);
+        ++invalidated;
+      }
+    }
+    stats.numEntries -= invalidated;
+    return invalidated;
+  }
+
   void clear() {
     valid.reset();
     stats.reset();
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "dd/Concurrency.hpp"
 #include "dd/DDDefinitions.hpp"
 #include "dd/Edge.hpp"
 #include "dd/MemoryManager.hpp"
@@ -13,6 +14,8 @@
 #include <cstddef>
 #include <cstdint>
 #include <iostream>
+#include <mutex>
+#include <stdexcept>
 #include <type_traits>
 #include <vector>
 
@@ -20,8 +23,15 @@ namespace dd {
 
 /**
  * @brief Data structure for uniquely storing DD nodes
+ * @details The table for each variable starts out with NBUCKET buckets and
+ * doubles its number of buckets whenever the average chain length exceeds the
+ * maximum load factor. Growing a table does not rehash all nodes at once.
+ * Instead, a few buckets of the previous table are migrated to the new table
+ * on every subsequent lookup for the respective variable (incremental
+ * rehashing). Tables of density matrix nodes are never grown.
  * @tparam Node class of nodes to provide/store
- * @tparam NBUCKET number of hash buckets to use (has to be a power of two)
+ * @tparam NBUCKET initial number of hash buckets to use (has to be a power of
+ * two)
  */
 template <class Node, std::size_t NBUCKET = 32768> class UniqueTable {
 
@@ -40,6 +50,28 @@ public:
    */
   static constexpr std::size_t INITIAL_GC_LIMIT = 131072U;
 
+  /**
+   * @brief The number of lock shards used for concurrent access.
+   * @details If concurrent access is enabled, the per-variable tables are
+   * guarded by a fixed number of mutexes. The table (and the statistics) of
+   * variable `v` is guarded by the mutex with index `v % NUM_SHARDS`. Hence,
+   * lookups for nodes on different levels of a DD do not contend with each
+   * other.
+   */
+  static constexpr std::size_t NUM_SHARDS = 64U;
+
+  /**
+   * @brief The default maximum load factor.
+   * @details Once the average number of nodes per bucket in the table of a
+   * variable exceeds this value, the table of that variable is grown.
+   */
+  static constexpr double DEFAULT_MAX_LOAD_FACTOR = 2.;
+
+  /**
+   * @brief The number of buckets migrated per lookup while growing a table.
+   */
+  static constexpr std::size_t REHASH_STEPS = 8U;
+
   /**
    * @brief The default constructor
    * @param nv The number of variables
@@ -48,22 +80,21 @@ public:
    */
   explicit UniqueTable(const std::size_t nv, MemoryManager<Node>& manager,
                        std::size_t initialGCLim = INITIAL_GC_LIMIT)
-      : nvars(nv), memoryManager(&manager), initialGCLimit(initialGCLim) {
-    for (auto& stat : stats) {
-      stat.entrySize = sizeof(Bucket);
-      stat.numBuckets = NBUCKET;
-    }
+      : memoryManager(&manager), initialGCLimit(initialGCLim) {
+    resize(nv);
   }
 
   void resize(std::size_t nq) {
     nvars = nq;
-    tables.resize(nq);
+    tables.resize(nq, std::vector<Bucket>(NBUCKET, nullptr));
     // TODO: if the new size is smaller than the old one we might have to
     // release the unique table entries for the superfluous variables
+    oldTables.resize(nq);
+    migrated.resize(nq, 0U);
     stats.resize(nq);
-    for (auto& stat : stats) {
-      stat.entrySize = sizeof(Bucket);
-      stat.numBuckets = NBUCKET;
+    for (std::size_t v = 0U; v < nq; ++v) {
+      stats[v].entrySize = sizeof(Bucket);
+      stats[v].numBuckets = tables[v].size() + oldTables[v].size();
     }
   }
 
@@ -71,18 +102,44 @@ public:
    * @brief The hash function for the hash table.
    * @details The hash function just combines the hashes of the edges of the
    * node. The hash value is masked to ensure that it is in the range
-   * [0, NBUCKET - 1].
+   * [0, numBuckets - 1].
    * @param p The node to hash.
+   * @param numBuckets The number of buckets of the table (has to be a power of
+   * two).
    * @returns The hash value of the node.
    */
-  static std::size_t hash(const Node* p) {
-    static constexpr std::size_t MASK = NBUCKET - 1;
-    std::size_t key = 0U;
-    for (std::size_t i = 0U; i < p->e.size(); ++i) {
-      qc::hashCombine(key, std::hash<Edge<Node>>{}(p->e[i]));
+  static std::size_t hash(const Node* p,
+                          const std::size_t numBuckets = NBUCKET) {
+    return fullHash(p) & (numBuckets - 1);
+  }
+
+  /**
+   * @brief Set the maximum load factor of the table.
+   * @details Once the average number of nodes per bucket in the table of a
+   * variable exceeds this value, the number of buckets of the table is
+   * doubled.
+   * @param maxLoad The maximum load factor (must be positive).
+   */
+  void setMaxLoadFactor(const double maxLoad) {
+    if (maxLoad <= 0.) {
+      throw std::invalid_argument("Maximum load factor must be positive.");
     }
-    key &= MASK;
-    return key;
+    maxLoadFactor = maxLoad;
+  }
+
+  /// Get the maximum load factor of the table
+  [[nodiscard]] double getMaxLoadFactor() const noexcept {
+    return maxLoadFactor;
+  }
+
+  /// Get the current number of buckets of the table for a variable
+  [[nodiscard]] std::size_t getNumBuckets(const std::size_t v) const {
+    return tables.at(v).size();
+  }
+
+  /// Check whether the table for a variable is currently being grown
+  [[nodiscard]] bool isRehashing(const std::size_t v) const {
+    return !oldTables.at(v).empty();
   }
 
   /// Get a reference to the table
@@ -168,6 +225,19 @@ public:
     }
   }
 
+  /**
+   * @brief Enable or disable concurrent access to the table.
+   * @details If enabled, `lookup` may be called from multiple threads
+   * simultaneously. The table is sharded by variable and each shard is guarded
+   * by its own mutex (see NUM_SHARDS). Reference counting, garbage collection,
+   * resizing, and clearing must still not be performed concurrently.
+   * @param enable Whether to enable concurrent access.
+   */
+  void setConcurrent(const bool enable) noexcept { concurrent = enable; }
+
+  /// Check whether concurrent access is enabled
+  [[nodiscard]] bool isConcurrent() const noexcept { return concurrent; }
+
   // lookup a node in the unique table for the appropriate variable; insert it,
   // if it has not been found NOTE: reference counting is to be adjusted by
   // function invoking the table lookup and only normalized nodes shall be
@@ -178,21 +248,39 @@ public:
       return p;
     }
 
-    const auto key = hash(p);
+    const auto h = fullHash(p);
     const auto v = p->v;
+    const auto lock = conditionalLock(shards[v % NUM_SHARDS], concurrent);
     ++stats[v].lookups;
 
+    if (isRehashing(v)) {
+      migrateBuckets(v, REHASH_STEPS);
+    }
+
     // search bucket in table corresponding to hashed value for the given node
     // and return it if found.
-    if (auto* hashedNode = searchTable(p, key); !Node::isTerminal(hashedNode)) {
+    if (auto* hashedNode = searchTable(p, h); !Node::isTerminal(hashedNode)) {
       return hashedNode;
     }
 
     // if node not found -> add it to front of unique table bucket
-    p->next = tables[v][key];
-    tables[v][key] = p;
+    auto& table = tables[v];
+    const auto key = h & (table.size() - 1);
+    p->next = table[key];
+    table[key] = p;
     stats[v].trackInsert();
 
+    // Density matrix nodes are temporarily modified in-place during
+    // operations, which changes their hash values. Hence, they are never
+    // rehashed.
+    if constexpr (!std::is_same_v<Node, dNode>) {
+      if (!isRehashing(v) && static_cast<double>(stats[v].numEntries) >
+                                 maxLoadFactor *
+                                     static_cast<double>(table.size())) {
+        grow(v);
+      }
+    }
+
     return p;
   }
 
@@ -242,32 +330,12 @@ public:
       return 0U;
     }
 
-    std::size_t v = 0U;
-    for (auto& table : tables) {
+    for (std::size_t v = 0U; v < tables.size(); ++v) {
       auto& stat = stats[v];
       ++stat.gcRuns;
-      for (auto& bucket : table) {
-        Node* p = bucket;
-        Node* lastp = nullptr;
-        while (p != nullptr) {
-          if (p->ref == 0) {
-            Node* next = p->next;
-            if (lastp == nullptr) {
-              bucket = next;
-            } else {
-              lastp->next = next;
-            }
-            memoryManager->returnEntry(p);
-            p = next;
-            --stat.numEntries;
-          } else {
-            lastp = p;
-            p = p->next;
-          }
-        }
-      }
+      collectBuckets(tables[v], stat);
+      collectBuckets(oldTables[v], stat);
       stat.numActiveEntries = stat.numEntries;
-      ++v;
     }
 
     // The garbage collection limit changes dynamically depending on the number
@@ -284,13 +352,56 @@ public:
     return numEntriesBefore - numEntries;
   }
 
-  void clear() {
-    // clear unique table buckets
-    for (auto& table : tables) {
-      for (auto& bucket : table) {
-        bucket = nullptr;
+  /**
+   * @brief Update the table after its nodes have been relocated
+   * @details Replaces every node in the table by its new address according to
+   * @p relocation (see MemoryManager::compact) and passes it to @p rewire,
+   * which is expected to update the edges of the node. Since the hash of a
+   * node depends on its edges, all nodes are rehashed afterwards. A table that
+   * is currently being grown is migrated completely.
+   * @param relocation The mapping from previous to new node addresses.
+   * @param rewire The function updating the edges of a relocated node.
+   */
+  template <class Rewire>
+  void relocate(const Relocation<Node>& relocation, Rewire&& rewire) {
+    std::vector<Node*> nodes{};
+    for (std::size_t v = 0U; v < tables.size(); ++v) {
+      nodes.clear();
+      // the previous addresses are never dereferenced, so the chains are
+      // followed via the `next` pointers of the relocated nodes
+      for (auto* table : {&tables[v], &oldTables[v]}) {
+        for (auto* bucket : *table) {
+          for (auto* p = bucket; p != nullptr;) {
+            auto* relocated = relocation.at(p);
+            nodes.emplace_back(relocated);
+            p = relocated->next;
+          }
+        }
+      }
+
+      auto& table = tables[v];
+      table.assign(table.size(), nullptr);
+      std::vector<Bucket>().swap(oldTables[v]);
+      migrated[v] = 0U;
+      stats[v].numBuckets = table.size();
+      const auto mask = table.size() - 1;
+      for (auto* p : nodes) {
+        rewire(p);
+        auto& bucket = table[fullHash(p) & mask];
+        p->next = bucket;
+        bucket = p;
       }
     }
+  }
+
+  void clear() {
+    // clear unique table buckets and shrink the tables to their initial size
+    for (std::size_t v = 0U; v < tables.size(); ++v) {
+      tables[v].assign(NBUCKET, nullptr);
+      std::vector<Bucket>().swap(oldTables[v]);
+      migrated[v] = 0U;
+      stats[v].numBuckets = NBUCKET;
+    }
     gcLimit = initialGCLimit;
     for (auto& stat : stats) {
       stat.reset();
@@ -300,6 +411,10 @@ public:
   void print() {
     auto q = nvars - 1U;
     for (auto it = tables.rbegin(); it != tables.rend(); ++it) {
+      if (isRehashing(q)) {
+        // finish the migration so that all nodes are in the current table
+        migrateBuckets(q, oldTables[q].size());
+      }
       auto& table = *it;
       std::cout << "\tq" << q << ":"
                 << "\n";
@@ -329,7 +444,7 @@ private:
   /// Typedef for a bucket in the table
   using Bucket = Node*;
   /// Typedef for the table
-  using Table = std::array<Bucket, NBUCKET>;
+  using Table = std::vector<Bucket>;
 
   /// The number of variables
   std::size_t nvars = 0U;
@@ -339,29 +454,84 @@ private:
    * list of entries. The linked list is implemented by using the next pointer
    * of the entries.
    */
-  std::vector<Table> tables{nvars};
+  std::vector<Table> tables;
+
+  /**
+   * @brief The previous tables of variables that are currently being grown
+   * @details While a table is grown, its previous buckets are kept here and
+   * migrated to the new table incrementally. The table of a variable is empty
+   * if no migration is in progress.
+   */
+  std::vector<Table> oldTables;
+
+  /// The number of buckets that have already been migrated per variable
+  std::vector<std::size_t> migrated;
+
+  /// The maximum load factor before a table is grown
+  double maxLoadFactor = DEFAULT_MAX_LOAD_FACTOR;
 
   /// A pointer to the memory manager for the nodes stored in the table.
   MemoryManager<Node>* memoryManager;
 
   /// A collection of statistics
-  std::vector<UniqueTableStatistics> stats{nvars};
+  std::vector<UniqueTableStatistics> stats;
 
   /// The initial garbage collection limit
   std::size_t initialGCLimit;
   /// The current garbage collection limit
   std::size_t gcLimit = initialGCLimit;
 
+  /// Whether concurrent access to the table is enabled
+  bool concurrent = false;
+  /// The mutexes guarding the individual shards of the table
+  std::array<std::mutex, NUM_SHARDS> shards{};
+
   /**
-  Searches for a node in the hash table with the given key.
-  @param e The node to search for.
-  @param key The hashed value used to search the table.
+   * @brief Compute the (unmasked) hash value of a node
+   * @param p The node to hash.
+   * @returns The hash value of the node.
+   */
+  static std::size_t fullHash(const Node* p) {
+    std::size_t key = 0U;
+    for (std::size_t i = 0U; i < p->e.size(); ++i) {
+      qc::hashCombine(key, std::hash<Edge<Node>>{}(p->e[i]));
+    }
+    return key;
+  }
+
+  /**
+  Searches for a node in the hash table with the given hash value.
+  @param p The node to search for.
+  @param h The (unmasked) hash value of the node.
   @return The Edge<Node> found in the hash table or Edge<Node>::zero if not
   found.
   **/
-  Node* searchTable(Node* p, const std::size_t& key) {
+  Node* searchTable(Node* p, const std::size_t h) {
+    const auto v = p->v;
+    const auto& table = tables[v];
+    if (auto* node = searchBucket(p, table[h & (table.size() - 1)]);
+        !Node::isTerminal(node)) {
+      return node;
+    }
+    // nodes in buckets of the previous table that have not been migrated yet
+    if (const auto& oldTable = oldTables[v]; !oldTable.empty()) {
+      if (const auto oldKey = h & (oldTable.size() - 1);
+          oldKey >= migrated[v]) {
+        return searchBucket(p, oldTable[oldKey]);
+      }
+    }
+    // Node not found
+    return Node::getTerminal();
+  }
+
+  /**
+  Searches for a node in the bucket chain starting at the given node.
+  @param p The node to search for.
+  @param bucket The first node of the bucket chain.
+  @return The node found in the bucket or a terminal if not found.
+  **/
+  Node* searchBucket(Node* p, Node* bucket) {
     const auto v = p->v;
-    Node* bucket = tables[v][key];
     while (bucket != nullptr) {
       if (nodesAreEqual(p, bucket)) {
         // Match found
@@ -379,6 +549,76 @@ private:
     // Node not found in bucket
     return Node::getTerminal();
   }
+
+  /**
+   * @brief Start growing the table of a variable
+   * @details Doubles the number of buckets of the table. The nodes of the
+   * previous table are migrated incrementally on subsequent lookups.
+   * @param v The variable whose table to grow.
+   */
+  void grow(const std::size_t v) {
+    auto& table = tables[v];
+    oldTables[v] = std::move(table);
+    table.assign(oldTables[v].size() * 2U, nullptr);
+    migrated[v] = 0U;
+    stats[v].numBuckets = table.size() + oldTables[v].size();
+  }
+
+  /**
+   * @brief Migrate buckets of the previous table of a variable
+   * @param v The variable whose buckets to migrate.
+   * @param steps The maximum number of buckets to migrate.
+   */
+  void migrateBuckets(const std::size_t v, const std::size_t steps) {
+    auto& table = tables[v];
+    auto& oldTable = oldTables[v];
+    const auto mask = table.size() - 1;
+    const auto end = std::min(oldTable.size(), migrated[v] + steps);
+    for (auto& idx = migrated[v]; idx < end; ++idx) {
+      Node* p = oldTable[idx];
+      while (p != nullptr) {
+        Node* next = p->next;
+        auto& bucket = table[fullHash(p) & mask];
+        p->next = bucket;
+        bucket = p;
+        p = next;
+      }
+      oldTable[idx] = nullptr;
+    }
+    if (migrated[v] == oldTable.size()) {
+      std::vector<Bucket>().swap(oldTable);
+      migrated[v] = 0U;
+      stats[v].numBuckets = table.size();
+    }
+  }
+
+  /**
+   * @brief Return all dead nodes of the given buckets to the memory manager
+   * @param table The buckets to collect.
+   * @param stat The statistics to update.
+   */
+  void collectBuckets(Table& table, UniqueTableStatistics& stat) {
+    for (auto& bucket : table) {
+      Node* p = bucket;
+      Node* lastp = nullptr;
+      while (p != nullptr) {
+        if (p->ref == 0) {
+          Node* next = p->next;
+          if (lastp == nullptr) {
+            bucket = next;
+          } else {
+            lastp->next = next;
+          }
+          memoryManager->returnEntry(p);
+          p = next;
+          --stat.numEntries;
+        } else {
+          lastp = p;
+          p = p->next;
+        }
+      }
+    }
+  }
 };
 
 } // namespace dd
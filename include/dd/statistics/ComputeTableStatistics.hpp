@@ -0,0 +1,52 @@
+#pragma once
+
+#include "dd/statistics/TableStatistics.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace dd {
+/// \brief A class for storing statistics of a compute table
+struct ComputeTableStatistics : public TableStatistics {
+  /// The number of ways (entries per bucket) of the table
+  std::size_t numWays = 1U;
+  /**
+   * @brief The number of successful lookups per way
+   * @details Entries within a bucket are kept in least-recently-used order.
+   * Hence, way `i` corresponds to the `i`-th most recently used entry.
+   */
+  std::vector<std::size_t> hitsPerWay = std::vector<std::size_t>(1U, 0U);
+  /// The number of valid entries that were evicted to make room for others
+  std::size_t evictions = 0U;
+
+  /// The number of garbage collections after which the table was swept
+  std::size_t gcRuns = 0U;
+  /// The number of entries invalidated because they referred to collected data
+  std::size_t gcInvalidations = 0U;
+  /// The number of entries that were retained during garbage collections
+  std::size_t gcRetentions = 0U;
+  /// The number of successful lookups before the first garbage collection
+  std::size_t hitsBeforeGC = 0U;
+  /// The number of lookups before the first garbage collection
+  std::size_t lookupsBeforeGC = 0U;
+
+  /// Set the number of ways and reset the per-way statistics
+  void setNumWays(std::size_t ways);
+
+  /**
+   * @brief Track a sweep of the table after a garbage collection
+   * @param invalidated The number of entries that have been invalidated.
+   */
+  void trackCollection(std::size_t invalidated) noexcept;
+
+  /// Get the hit ratio of lookups before the first garbage collection
+  [[nodiscard]] double hitRatioBeforeGC() const noexcept;
+
+  /// Get the hit ratio of lookups after the first garbage collection
+  [[nodiscard]] double hitRatioAfterGC() const noexcept;
+
+  /// Get a JSON representation of the statistics
+  [[nodiscard]] nlohmann::json json() const override;
+};
+
+} // namespace dd
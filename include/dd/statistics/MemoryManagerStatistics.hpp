@@ -25,6 +25,10 @@ template <typename T> struct MemoryManagerStatistics : public Statistics {
   std::size_t peakNumUsed = 0U;
   /// The peak number of entries available for reuse
   std::size_t peakNumAvailableForReuse = 0U;
+  /// The number of compactions performed
+  std::size_t numCompactions = 0U;
+  /// The total number of bytes released by compactions and chunk releases
+  std::size_t reclaimedBytes = 0U;
 
   static constexpr auto ENTRY_MEMORY_MIB =
       static_cast<double>(sizeof(T)) / static_cast<double>(1ULL << 20U);
@@ -38,6 +42,19 @@ template <typename T> struct MemoryManagerStatistics : public Statistics {
   /// Get an estimate for ratio of used memory
   [[nodiscard]] double getUsageRatio() const noexcept;
 
+  /**
+   * @brief Get the fragmentation of the allocated memory
+   * @details The fragmentation is the ratio of allocated entries that are
+   * available for reuse, i.e., entries that have been returned to the manager
+   * and are interspersed with entries in use. Entries in the current chunk
+   * that have never been used do not count as fragmented.
+   * @returns The fragmentation ratio in [0, 1].
+   */
+  [[nodiscard]] double getFragmentation() const noexcept;
+
+  /// Get the total memory reclaimed by compactions and chunk releases in MiB
+  [[nodiscard]] double getReclaimedMemoryMiB() const noexcept;
+
   /// Get an estimate of the total allocated memory in MiB
   [[nodiscard]] double getAllocatedMemoryMiB() const noexcept;
 
@@ -0,0 +1,262 @@
+#pragma once
+
+#include "dd/Edge.hpp"
+#include "dd/Package.hpp"
+#include "dd/statistics/Statistics.hpp"
+#include "dd/statistics/UniqueTableStatistics.hpp"
+#include "operations/Operation.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace dd {
+
+/**
+ * @brief The figures recorded for a single operation
+ * @details Lookups, hits, collected entries, and memory growth are deltas over
+ * the application of the operation including the subsequent garbage
+ * collection. Lookups and hits are summed over all binary compute tables.
+ * Single-target gates applied by `Package::applyGate` only memoize within the
+ * application itself, so that their lookups are hardly reflected here.
+ */
+struct OperationTraceEvent : public Statistics {
+  /// The index of the operation in the circuit
+  std::size_t index = 0U;
+  /// The name of the operation
+  std::string operation;
+  /// The wall time spent on the operation in seconds
+  double runtime = 0.;
+  /// The number of nodes of the DD before the operation
+  std::size_t nodesBefore = 0U;
+  /// The number of nodes of the DD after the operation
+  std::size_t nodesAfter = 0U;
+  /// The number of compute table lookups performed by the operation
+  std::size_t computeTableLookups = 0U;
+  /// The number of successful compute table lookups of the operation
+  std::size_t computeTableHits = 0U;
+  /// The number of vector nodes collected by the garbage collection
+  std::size_t collectedVectorNodes = 0U;
+  /// The number of matrix nodes collected by the garbage collection
+  std::size_t collectedMatrixNodes = 0U;
+  /// The number of density matrix nodes collected by the garbage collection
+  std::size_t collectedDensityMatrixNodes = 0U;
+  /// The number of real numbers collected by the garbage collection
+  std::size_t collectedRealNumbers = 0U;
+  /// The memory allocated by the memory managers after the operation in MiB
+  double allocatedMemoryMiB = 0.;
+  /// The change of the allocated memory caused by the operation in MiB
+  double allocatedMemoryGrowthMiB = 0.;
+
+  /// The names of the fields in the order used by `json` and CSV traces
+  static constexpr std::array<const char*, 13U> FIELDS{
+      "index",
+      "operation",
+      "runtime",
+      "nodes_before",
+      "nodes_after",
+      "compute_table_lookups",
+      "compute_table_hits",
+      "collected_vector_nodes",
+      "collected_matrix_nodes",
+      "collected_density_matrix_nodes",
+      "collected_real_numbers",
+      "memory_allocated_MiB",
+      "memory_allocated_growth_MiB"};
+
+  /// Get a JSON representation of the event
+  [[nodiscard]] nlohmann::json json() const override;
+};
+
+/**
+ * @brief Receives the trace events of a simulation or functionality
+ * construction
+ * @details Tracers are passed to `simulate` or `buildFunctionality` and are
+ * called once per operation, right after the operation has been applied. For
+ * dynamic circuits simulated shot by shot, every shot is traced separately.
+ * When branching on measurement outcomes, every branch is traced separately
+ * and measurements themselves are not traced.
+ */
+class OperationTracer {
+public:
+  virtual ~OperationTracer() = default;
+
+  /// Record the event of a single operation
+  virtual void record(const OperationTraceEvent& event) = 0;
+};
+
+/**
+ * @brief A tracer streaming events as JSON Lines
+ * @details Every event is written as a single-line JSON object as soon as it
+ * is recorded, using the same key conventions as `getStatistics`.
+ */
+class JSONTraceWriter : public OperationTracer {
+public:
+  explicit JSONTraceWriter(std::ostream& stream) : os(&stream) {}
+
+  void record(const OperationTraceEvent& event) override;
+
+private:
+  std::ostream* os;
+};
+
+/**
+ * @brief A tracer streaming events as CSV
+ * @details A header line naming the fields is written before the first event.
+ */
+class CSVTraceWriter : public OperationTracer {
+public:
+  explicit CSVTraceWriter(std::ostream& stream) : os(&stream) {}
+
+  void record(const OperationTraceEvent& event) override;
+
+private:
+  std::ostream* os;
+  bool headerWritten = false;
+};
+
+/**
+ * @brief Helper for collecting trace events in simulation loops
+ * @details Does nothing but checking for a tracer if tracing is disabled.
+ * Otherwise, `start` and `stop` have to be called around the application of
+ * every operation (including the subsequent garbage collection). Operations
+ * that are not applied have to be passed over with `skip`, so that the index
+ * of every event matches the position of its operation in the circuit.
+ */
+template <class Config> class OperationTraceRecorder {
+public:
+  OperationTraceRecorder(OperationTracer* operationTracer,
+                         Package<Config>& package)
+      : tracer(operationTracer), dd(&package) {}
+
+  /// Check whether tracing is enabled
+  [[nodiscard]] bool enabled() const noexcept { return tracer != nullptr; }
+
+  /// Take a snapshot of the package before applying an operation to @p e
+  template <class Node> void start(const Edge<Node>& e) {
+    if (!enabled()) {
+      return;
+    }
+    // the size is only known if @p e resulted from the previous operation
+    if (!sizeKnown) {
+      lastSize = e.size();
+      sizeKnown = true;
+    }
+    lookups = computeTableLookups();
+    hits = computeTableHits();
+    removedVectorNodes = removedEntries(dd->vUniqueTable.getStats());
+    removedMatrixNodes = removedEntries(dd->mUniqueTable.getStats());
+    removedDensityMatrixNodes = removedEntries(dd->dUniqueTable.getStats());
+    removedRealNumbers = removedEntries(dd->cUniqueTable.getStats());
+    allocatedMemoryMiB = allocatedMemory();
+    startTime = std::chrono::steady_clock::now();
+  }
+
+  /// Record the event of @p op, which resulted in @p e
+  template <class Node>
+  void stop(const qc::Operation& op, const Edge<Node>& e) {
+    if (!enabled()) {
+      return;
+    }
+    const auto runtime = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - startTime);
+    OperationTraceEvent event{};
+    event.index = index++;
+    event.operation = op.getName();
+    event.runtime = runtime.count();
+    event.nodesBefore = lastSize;
+    event.nodesAfter = lastSize = e.size();
+    event.computeTableLookups = computeTableLookups() - lookups;
+    event.computeTableHits = computeTableHits() - hits;
+    event.collectedVectorNodes =
+        removedEntries(dd->vUniqueTable.getStats()) - removedVectorNodes;
+    event.collectedMatrixNodes =
+        removedEntries(dd->mUniqueTable.getStats()) - removedMatrixNodes;
+    event.collectedDensityMatrixNodes =
+        removedEntries(dd->dUniqueTable.getStats()) -
+        removedDensityMatrixNodes;
+    event.collectedRealNumbers =
+        removedEntries(dd->cUniqueTable.getStats()) - removedRealNumbers;
+    event.allocatedMemoryMiB = allocatedMemory();
+    event.allocatedMemoryGrowthMiB =
+        event.allocatedMemoryMiB - allocatedMemoryMiB;
+    tracer->record(event);
+  }
+
+  /// Pass over an operation that is not applied
+  void skip() noexcept { ++index; }
+
+  /**
+   * @brief Continue tracing with an unrelated DD
+   * @details Has to be called whenever the next operation is not applied to
+   * the result of the previous one, e.g., at the start of a new shot.
+   * @param nextIndex The position of the next operation in the circuit.
+   */
+  void restart(const std::size_t nextIndex) noexcept {
+    index = nextIndex;
+    sizeKnown = false;
+  }
+
+private:
+  OperationTracer* tracer;
+  Package<Config>* dd;
+
+  std::size_t index = 0U;
+  std::size_t lastSize = 0U;
+  bool sizeKnown = false;
+  std::size_t lookups = 0U;
+  std::size_t hits = 0U;
+  std::size_t removedVectorNodes = 0U;
+  std::size_t removedMatrixNodes = 0U;
+  std::size_t removedDensityMatrixNodes = 0U;
+  std::size_t removedRealNumbers = 0U;
+  double allocatedMemoryMiB = 0.;
+  std::chrono::steady_clock::time_point startTime;
+
+  template <class F> [[nodiscard]] std::size_t sumComputeTables(F&& f) const {
+    return f(dd->vectorAdd) + f(dd->matrixAdd) + f(dd->densityAdd) +
+           f(dd->matrixVectorMultiplication) +
+           f(dd->matrixMatrixMultiplication) +
+           f(dd->densityDensityMultiplication) + f(dd->vectorKronecker) +
+           f(dd->matrixKronecker) + f(dd->vectorInnerProduct) +
+           f(dd->matrixTrace) + f(dd->matrixIdentity);
+  }
+
+  [[nodiscard]] std::size_t computeTableLookups() const {
+    return sumComputeTables(
+        [](const auto& table) { return table.getStats().lookups; });
+  }
+
+  [[nodiscard]] std::size_t computeTableHits() const {
+    return sumComputeTables(
+        [](const auto& table) { return table.getStats().hits; });
+  }
+
+  /// The number of entries ever removed from a unique table
+  [[nodiscard]] static std::size_t
+  removedEntries(const UniqueTableStatistics& stats) noexcept {
+    return stats.inserts - stats.numEntries;
+  }
+
+  /// The number of entries ever removed from the per-variable unique tables
+  [[nodiscard]] static std::size_t
+  removedEntries(const std::vector<UniqueTableStatistics>& stats) noexcept {
+    std::size_t removed = 0U;
+    for (const auto& stat : stats) {
+      removed += removedEntries(stat);
+    }
+    return removed;
+  }
+
+  [[nodiscard]] double allocatedMemory() const {
+    return dd->vMemoryManager.getStats().getAllocatedMemoryMiB() +
+           dd->mMemoryManager.getStats().getAllocatedMemoryMiB() +
+           dd->dMemoryManager.getStats().getAllocatedMemoryMiB() +
+           dd->cMemoryManager.getStats().getAllocatedMemoryMiB();
+  }
+};
+
+} // namespace dd
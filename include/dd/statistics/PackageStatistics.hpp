@@ -1,8 +1,11 @@
 #pragma once
 
 #include "dd/Package.hpp"
+#include "dd/statistics/ComputeTableStatistics.hpp"
 #include "nlohmann/json.hpp"
 
+#include <cstddef>
+
 namespace dd {
 
 static constexpr auto V_NODE_MEMORY_MIB =
@@ -95,6 +98,63 @@ template <class Config>
   return memoryForNodes + memoryForEdges + memoryForRealNumbers;
 }
 
+/**
+ * @brief Summarize the effect of garbage collection on the compute tables
+ * @details Garbage collection only invalidates the compute table entries
+ * referring to collected data. The summary reports how many entries have been
+ * invalidated and retained over all binary compute tables as well as their
+ * combined hit ratio before and after the first garbage collection.
+ * @tparam Config The package configuration
+ * @param package The package instance
+ * @return A JSON representation of the summary
+ */
+template <class Config = DDPackageConfig>
+[[nodiscard]] static nlohmann::json
+computeTableGCStatistics(Package<Config>* package) {
+  std::size_t invalidations = 0U;
+  std::size_t retentions = 0U;
+  std::size_t hitsBefore = 0U;
+  std::size_t lookupsBefore = 0U;
+  std::size_t hitsAfter = 0U;
+  std::size_t lookupsAfter = 0U;
+  const auto accumulate = [&](const ComputeTableStatistics& stats) {
+    invalidations += stats.gcInvalidations;
+    retentions += stats.gcRetentions;
+    if (stats.gcRuns == 0U) {
+      hitsBefore += stats.hits;
+      lookupsBefore += stats.lookups;
+      return;
+    }
+    hitsBefore += stats.hitsBeforeGC;
+    lookupsBefore += stats.lookupsBeforeGC;
+    hitsAfter += stats.hits - stats.hitsBeforeGC;
+    lookupsAfter += stats.lookups - stats.lookupsBeforeGC;
+  };
+  accumulate(package->vectorAdd.getStats());
+  accumulate(package->matrixAdd.getStats());
+  accumulate(package->densityAdd.getStats());
+  accumulate(package->matrixVectorMultiplication.getStats());
+  accumulate(package->matrixMatrixMultiplication.getStats());
+  accumulate(package->densityDensityMultiplication.getStats());
+  accumulate(package->vectorKronecker.getStats());
+  accumulate(package->matrixKronecker.getStats());
+  accumulate(package->vectorInnerProduct.getStats());
+  accumulate(package->matrixTrace.getStats());
+  accumulate(package->matrixIdentity.getStats());
+
+  const auto ratio = [](const std::size_t hits, const std::size_t lookups) {
+    return lookups == 0U
+               ? 1.
+               : static_cast<double>(hits) / static_cast<double>(lookups);
+  };
+  nlohmann::json j;
+  j["invalidations"] = invalidations;
+  j["retentions"] = retentions;
+  j["hit_ratio_before_gc"] = ratio(hitsBefore, lookupsBefore);
+  j["hit_ratio_after_gc"] = ratio(hitsAfter, lookupsAfter);
+  return j;
+}
+
 template <class Config = DDPackageConfig>
 [[nodiscard]] static nlohmann::json
 getStatistics(Package<Config>* package,
@@ -138,11 +198,17 @@ getStatistics(Package<Config>* package,
       package->matrixKronecker.getStats().json();
   computeTables["vector_inner_product"] =
       package->vectorInnerProduct.getStats().json();
+  computeTables["matrix_trace"] = package->matrixTrace.getStats().json();
+  computeTables["matrix_identity"] = package->matrixIdentity.getStats().json();
   computeTables["stochastic_noise_operations"] =
       package->stochasticNoiseOperationCache.getStats().json();
   computeTables["density_noise_operations"] =
       package->densityNoise.getStats().json();
 
+  j["compute_table_gc"] = computeTableGCStatistics(package);
+
+  j["gate_cache"] = package->gateCache.getStats().json();
+
   j["active_memory_mib"] = computeActiveMemoryMiB(package);
   j["peak_memory_mib"] = computePeakMemoryMiB(package);
 
@@ -266,6 +332,18 @@ getDataStructureStatistics(Package<Config>* package) {
   vectorInnerProduct["alignment_B"] =
       alignof(typename decltype(package->vectorInnerProduct)::Entry);
 
+  auto& matrixTrace = ctEntries["matrix_trace"];
+  matrixTrace["size_B"] =
+      sizeof(typename decltype(package->matrixTrace)::Entry);
+  matrixTrace["alignment_B"] =
+      alignof(typename decltype(package->matrixTrace)::Entry);
+
+  auto& matrixIdentity = ctEntries["matrix_identity"];
+  matrixIdentity["size_B"] =
+      sizeof(typename decltype(package->matrixIdentity)::Entry);
+  matrixIdentity["alignment_B"] =
+      alignof(typename decltype(package->matrixIdentity)::Entry);
+
   return j;
 }
 
@@ -1,6 +1,10 @@
 #include "CircuitOptimizer.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <map>
+#include <set>
+#include <vector>
 
 namespace qc {
 void CircuitOptimizer::removeIdentities(QuantumComputation& qc) {
@@ -292,6 +296,93 @@ void CircuitOptimizer::singleQubitGateFusion(QuantumComputation& qc) {
   removeIdentities(qc);
 }
 
+void CircuitOptimizer::collectBlocks(QuantumComputation& qc,
+                                     const std::size_t maxBlockSize) {
+  if (maxBlockSize == 0U) {
+    return;
+  }
+
+  Qubit highestPhysicalQubit = 0;
+  for (const auto& q : qc.initialLayout) {
+    if (q.first > highestPhysicalQubit) {
+      highestPhysicalQubit = q.first;
+    }
+  }
+
+  auto dag = DAG(highestPhysicalQubit + 1);
+  // the blocks created so far together with the qubits they act on
+  std::map<std::unique_ptr<Operation>*, std::set<Qubit>> blocks{};
+  // a block can only be extended as long as it ends the circuit on all of its
+  // qubits
+  const auto isOpen = [&dag, &blocks](std::unique_ptr<Operation>* op) {
+    const auto block = blocks.find(op);
+    return block != blocks.end() &&
+           std::all_of(block->second.begin(), block->second.end(),
+                       [&dag, op](const Qubit q) {
+                         return dag.at(q).back() == op;
+                       });
+  };
+
+  for (auto& it : qc.ops) {
+    if (!it->isStandardOperation()) {
+      addNonStandardOperationToDag(dag, &it);
+      continue;
+    }
+
+    auto usedQubits = it->getUsedQubits();
+    if (it->getType() == Barrier || usedQubits.empty() ||
+        usedQubits.size() > maxBlockSize) {
+      addToDag(dag, &it);
+      continue;
+    }
+
+    // greedily select the open blocks on the qubits of the gate that fit
+    std::vector<std::unique_ptr<Operation>*> selected{};
+    const auto gateQubits = usedQubits;
+    for (const auto q : gateQubits) {
+      if (dag.at(q).empty()) {
+        continue;
+      }
+      auto* op = dag.at(q).back();
+      if (std::find(selected.begin(), selected.end(), op) != selected.end() ||
+          !isOpen(op)) {
+        continue;
+      }
+      auto merged = usedQubits;
+      merged.insert(blocks.at(op).begin(), blocks.at(op).end());
+      if (merged.size() <= maxBlockSize) {
+        usedQubits = std::move(merged);
+        selected.emplace_back(op);
+      }
+    }
+
+    // the selected blocks act on disjoint qubits and no operation in between
+    // acts on any of them. Hence, they can be moved to the position of the
+    // gate.
+    auto block = std::make_unique<CompoundOperation>(it->getNqubits());
+    for (auto* op : selected) {
+      for (const auto q : blocks.at(op)) {
+        dag.at(q).pop_back();
+      }
+      blocks.erase(op);
+      auto* compound = dynamic_cast<CompoundOperation*>(op->get());
+      for (auto& gate : *compound) {
+        block->emplace_back(gate);
+      }
+      // the now empty compound operation is removed below
+      compound->clear();
+    }
+    block->emplace_back(it);
+    it = std::move(block);
+    for (const auto q : usedQubits) {
+      dag.at(q).push_back(&it);
+    }
+    blocks.emplace(&it, std::move(usedQubits));
+  }
+
+  removeIdentities(qc);
+}
+
 bool CircuitOptimizer::removeDiagonalGate(DAG& dag,
                                           DAGReverseIterators& dagIterators,
                                           Qubit idx, DAGReverseIterator& it,
@@ -1,46 +1,107 @@
 #include "dd/Benchmark.hpp"
 
+#include "CircuitOptimizer.hpp"
 #include "QuantumComputation.hpp"
 #include "dd/FunctionalityConstruction.hpp"
 #include "dd/Package.hpp"
 #include "dd/Simulation.hpp"
 #include "dd/statistics/PackageStatistics.hpp"
 
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+
 namespace dd {
 
+namespace {
+std::size_t countCompoundOperations(const QuantumComputation& qc) {
+  std::size_t count = 0U;
+  for (const auto& op : qc) {
+    if (op->isCompoundOperation()) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+/// Fuse the gates of a copy of @p qc and record the outcome in @p stats
+QuantumComputation fuseGates(const QuantumComputation& qc,
+                             const std::size_t blockSize,
+                             nlohmann::json& stats) {
+  QuantumComputation fused = qc;
+  CircuitOptimizer::collectBlocks(fused, blockSize);
+  // compound operations present before are never touched by the fusion
+  const auto blocks =
+      countCompoundOperations(fused) - countCompoundOperations(qc);
+  stats["block_size"] = blockSize;
+  stats["operations_before"] = qc.getNops();
+  stats["operations_after"] = fused.getNops();
+  stats["fused_blocks"] = blocks;
+  stats["fused_gates"] = qc.getNops() - fused.getNops() + blocks;
+  return fused;
+}
+} // namespace
+
 std::unique_ptr<SimulationExperiment>
-benchmarkSimulate(const QuantumComputation& qc) {
+benchmarkSimulate(const QuantumComputation& qc, OperationTracer* tracer,
+                  const std::size_t fusionBlockSize) {
   std::unique_ptr<SimulationExperiment> exp =
       std::make_unique<SimulationExperiment>();
   const auto nq = qc.getNqubits();
   exp->dd = std::make_unique<Package<>>(nq);
+  nlohmann::json fusionStats = nlohmann::json::object();
   const auto start = std::chrono::high_resolution_clock::now();
+  std::optional<QuantumComputation> fused{};
+  if (fusionBlockSize > 0U) {
+    fused = fuseGates(qc, fusionBlockSize, fusionStats);
+  }
   const auto in = exp->dd->makeZeroState(nq);
-  exp->sim = simulate(&qc, in, *(exp->dd));
+  exp->sim = simulate(fused ? &*fused : &qc, in, *(exp->dd), tracer);
   const auto end = std::chrono::high_resolution_clock::now();
   exp->runtime =
       std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
   exp->stats = dd::getStatistics(exp->dd.get());
+  if (fused) {
+    exp->stats["gate_fusion"] = fusionStats;
+  }
   return exp;
 }
 
 std::unique_ptr<FunctionalityConstructionExperiment>
 benchmarkFunctionalityConstruction(const QuantumComputation& qc,
-                                   const bool recursive) {
+                                   const bool recursive,
+                                   OperationTracer* tracer,
+                                   const std::size_t fusionBlockSize) {
+  if (recursive && tracer != nullptr) {
+    throw std::invalid_argument(
+        "Tracing is not supported by the recursive functionality "
+        "construction.");
+  }
   std::unique_ptr<FunctionalityConstructionExperiment> exp =
       std::make_unique<FunctionalityConstructionExperiment>();
   const auto nq = qc.getNqubits();
   exp->dd = std::make_unique<Package<>>(nq);
+  nlohmann::json fusionStats = nlohmann::json::object();
   const auto start = std::chrono::high_resolution_clock::now();
+  // the fused copy is a plain circuit, i.e., special handling of, e.g.,
+  // Grover circuits is lost
+  std::optional<QuantumComputation> fused{};
+  if (fusionBlockSize > 0U) {
+    fused = fuseGates(qc, fusionBlockSize, fusionStats);
+  }
+  const auto* circuit = fused ? &*fused : &qc;
   if (recursive) {
-    exp->func = buildFunctionalityRecursive(&qc, *(exp->dd));
+    exp->func = buildFunctionalityRecursive(circuit, *(exp->dd));
   } else {
-    exp->func = buildFunctionality(&qc, *(exp->dd));
+    exp->func = buildFunctionality(circuit, *(exp->dd), tracer);
   }
   const auto end = std::chrono::high_resolution_clock::now();
   exp->runtime =
       std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
   exp->stats = dd::getStatistics(exp->dd.get());
+  if (fused) {
+    exp->stats["gate_fusion"] = fusionStats;
+  }
   return exp;
 }
 
@@ -94,30 +94,38 @@ CachedEdge<Node>::normalize(Node* p,
     return CachedEdge::zero();
   }
 
+  const auto weights = std::array{e[0].w, e[1].w, e[2].w, e[3].w};
+  std::array<fp, NEDGE> mag2{};
+  for (auto i = 0U; i < NEDGE; ++i) {
+    mag2[i] = weights[i].mag2();
+  }
+
   std::optional<std::size_t> argMax = std::nullopt;
   fp maxMag2 = 0.;
-  ComplexValue maxVal = 1.;
   // determine max amplitude
   for (auto i = 0U; i < NEDGE; ++i) {
     if (zero[i]) {
       continue;
     }
-    const auto& w = e[i].w;
-    if (!argMax.has_value()) {
+    if (!argMax.has_value() || mag2[i] - maxMag2 > RealNumber::eps) {
       argMax = i;
-      maxMag2 = w.mag2();
-      maxVal = w;
-    } else {
-      if (const auto mag2 = w.mag2(); mag2 - maxMag2 > RealNumber::eps) {
-        argMax = i;
-        maxMag2 = mag2;
-        maxVal = w;
-      }
+      maxMag2 = mag2[i];
     }
   }
   assert(argMax.has_value() && "argMax should have been set by now");
 
   const auto argMaxValue = *argMax;
+  const auto maxVal = weights[argMaxValue];
+  // divide and look up all weights at once
+  auto normalized = weights;
+  divide(normalized.data(), NEDGE, maxVal);
+  for (auto i = 0U; i < NEDGE; ++i) {
+    // these weights are not looked up
+    if (zero[i] || i == argMaxValue) {
+      normalized[i] = 0.;
+    }
+  }
+  const auto lookedUp = cn.lookup(normalized);
   for (auto i = 0U; i < NEDGE; ++i) {
     // The approximation below is really important for numerical stability.
     // An exactly zero check will lead to numerical instabilities.
@@ -129,7 +137,7 @@ CachedEdge<Node>::normalize(Node* p,
       p->e[i] = {e[i].p, Complex::one()};
       continue;
     }
-    p->e[i] = {e[i].p, cn.lookup(e[i].w / maxVal)};
+    p->e[i] = {e[i].p, lookedUp[i]};
     if (p->e[i].w.exactlyZero()) {
       p->e[i].p = Node::getTerminal();
     }
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <iomanip>
 #include <istream>
 #include <ostream>
@@ -277,6 +278,20 @@ ComplexValue operator/(const ComplexValue& c1, const ComplexValue& c2) {
   return {gr / d, gi / d};
 }
 
+void divide(ComplexValue* values, const std::size_t count,
+            const ComplexValue& divisor) noexcept {
+  // see operator/ for the algorithm
+  const auto d = std::abs(divisor.i) <= std::abs(divisor.r)
+                     ? std::fma(divisor.r, divisor.r, divisor.i * divisor.i)
+                     : std::fma(divisor.i, divisor.i, divisor.r * divisor.r);
+  for (std::size_t k = 0U; k < count; ++k) {
+    auto& c = values[k];
+    const auto gr = kahan(c.r, c.i, divisor.r, divisor.i);
+    const auto gi = kahan(c.i, -c.r, divisor.r, divisor.i);
+    c = {gr / d, gi / d};
+  }
+}
+
 std::ostream& operator<<(std::ostream& os, const ComplexValue& c) {
   return os << ComplexValue::toString(c.r, c.i);
 }
@@ -6,6 +6,7 @@
 #include "dd/MemoryManager.hpp"
 #include "dd/Node.hpp"
 #include "dd/RealNumber.hpp"
+#include "dd/Traversal.hpp"
 
 #include <algorithm>
 #include <array>
@@ -16,7 +17,8 @@
 #include <iostream>
 #include <optional>
 #include <string>
-#include <unordered_set>
+#include <tuple>
+#include <vector>
 
 namespace dd {
 
@@ -56,23 +58,16 @@ Edge<Node>::getValueByPath(const std::string& decisions) const {
 
 template <class Node> std::size_t Edge<Node>::size() const {
   static constexpr std::size_t NODECOUNT_BUCKETS = 200000U;
-  static std::unordered_set<const Node*> visited{NODECOUNT_BUCKETS};
+  static VisitedSet<Node> visited{NODECOUNT_BUCKETS};
   visited.max_load_factor(10);
   visited.clear();
   return size(visited);
 }
 
 template <class Node>
-std::size_t Edge<Node>::size(std::unordered_set<const Node*>& visited) const {
-  visited.emplace(p);
+std::size_t Edge<Node>::size(VisitedSet<Node>& visited) const {
   std::size_t sum = 1U;
-  if (!isTerminal()) {
-    for (const auto& e : p->e) {
-      if (visited.find(e.p) == visited.end()) {
-        sum += e.size(visited);
-      }
-    }
-  }
+  traversePostOrder(p, visited, [&sum](const Node*) { ++sum; });
   return sum;
 }
 
@@ -238,24 +233,30 @@ template <typename T, isVector<T>>
 void Edge<Node>::traverseVector(const std::complex<fp>& amp,
                                 const std::size_t i, AmplitudeFunc f,
                                 const fp threshold) const {
-  // calculate new accumulated amplitude
-  const auto c = amp * static_cast<std::complex<fp>>(w);
-
-  if (std::abs(c) < threshold) {
-    return;
-  }
+  std::vector<std::tuple<const Edge*, std::complex<fp>, std::size_t>> stack{};
+  stack.emplace_back(this, amp, i);
+  while (!stack.empty()) {
+    const auto [e, a, idx] = stack.back();
+    stack.pop_back();
+
+    // calculate new accumulated amplitude
+    const auto c = a * static_cast<std::complex<fp>>(e->w);
+    if (std::abs(c) < threshold) {
+      continue;
+    }
 
-  if (isTerminal()) {
-    f(i, c);
-    return;
-  }
+    if (e->isTerminal()) {
+      f(idx, c);
+      continue;
+    }
 
-  // recursive case
-  if (const auto& e = p->e[0]; !e.w.exactlyZero()) {
-    e.traverseVector(c, i, f, threshold);
-  }
-  if (const auto& e = p->e[1]; !e.w.exactlyZero()) {
-    e.traverseVector(c, i | (1ULL << p->v), f, threshold);
+    // push the one-successor first so that amplitudes are visited in order
+    if (const auto& s = e->p->e[1]; !s.w.exactlyZero()) {
+      stack.emplace_back(&s, c, idx | (1ULL << e->p->v));
+    }
+    if (const auto& s = e->p->e[0]; !s.w.exactlyZero()) {
+      stack.emplace_back(&s, c, idx);
+    }
   }
 }
 
@@ -280,32 +281,38 @@ Edge<Node> Edge<Node>::normalize(Node* p,
       static_cast<ComplexValue>(e[0].w), static_cast<ComplexValue>(e[1].w),
       static_cast<ComplexValue>(e[2].w), static_cast<ComplexValue>(e[3].w)};
 
+  std::array<fp, NEDGE> mag2{};
+  for (auto i = 0U; i < NEDGE; ++i) {
+    mag2[i] = weights[i].mag2();
+  }
+
   std::optional<std::size_t> argMax = std::nullopt;
   fp maxMag2 = 0.;
-  auto maxVal = Complex::one();
   // determine max amplitude
   for (auto i = 0U; i < NEDGE; ++i) {
     if (zero[i]) {
       p->e[i] = Edge::zero();
       continue;
     }
-    const auto& w = weights[i];
-    if (!argMax.has_value()) {
+    if (!argMax.has_value() || mag2[i] - maxMag2 > RealNumber::eps) {
       argMax = i;
-      maxMag2 = w.mag2();
-      maxVal = e[i].w;
-    } else {
-      if (const auto mag2 = w.mag2(); mag2 - maxMag2 > RealNumber::eps) {
-        argMax = i;
-        maxMag2 = mag2;
-        maxVal = e[i].w;
-      }
+      maxMag2 = mag2[i];
     }
   }
   assert(argMax.has_value() && "argMax should have been set by now");
 
   const auto argMaxValue = *argMax;
-  const auto argMaxWeight = weights[argMaxValue];
+  const auto maxVal = e[argMaxValue].w;
+  // divide and look up all weights at once
+  auto normalized = weights;
+  divide(normalized.data(), NEDGE, weights[argMaxValue]);
+  for (auto i = 0U; i < NEDGE; ++i) {
+    // these weights are not looked up
+    if (zero[i] || i == argMaxValue) {
+      normalized[i] = 0.;
+    }
+  }
+  const auto lookedUp = cn.lookup(normalized);
   for (auto i = 0U; i < NEDGE; ++i) {
     if (zero[i]) {
       continue;
@@ -314,7 +321,7 @@ Edge<Node> Edge<Node>::normalize(Node* p,
       p->e[i] = {e[i].p, Complex::one()};
       continue;
     }
-    p->e[i] = {e[i].p, cn.lookup(weights[i] / argMaxWeight)};
+    p->e[i] = {e[i].p, lookedUp[i]};
     if (p->e[i].w.exactlyZero()) {
       p->e[i].p = Node::getTerminal();
     }
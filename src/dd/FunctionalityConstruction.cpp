@@ -1,8 +1,42 @@
 #include "dd/FunctionalityConstruction.hpp"
 
+#include "dd/ThreadPool.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
 namespace dd {
+namespace {
+/// Apply the changes `getDD` makes to the permutation for @p op without
+/// constructing its DD
+void updatePermutation(const Operation* op, Permutation& permutation) {
+  if (permutation.empty()) {
+    return;
+  }
+  if (op->getType() == qc::SWAP && !op->isControlled()) {
+    const auto& targets = op->getTargets();
+    std::swap(permutation.at(targets[0U]), permutation.at(targets[1U]));
+    return;
+  }
+  if (const auto* compoundOp = dynamic_cast<const CompoundOperation*>(op)) {
+    for (const auto& operation : *compoundOp) {
+      updatePermutation(operation.get(), permutation);
+    }
+    return;
+  }
+  if (const auto* classicOp =
+          dynamic_cast<const ClassicControlledOperation*>(op)) {
+    updatePermutation(classicOp->getOperation(), permutation);
+  }
+}
+} // namespace
+
 template <class Config>
-MatrixDD buildFunctionality(const QuantumComputation* qc, Package<Config>& dd) {
+MatrixDD buildFunctionality(const QuantumComputation* qc, Package<Config>& dd,
+                            OperationTracer* tracer) {
   const auto nq = qc->getNqubits();
   if (nq == 0U) {
     return MatrixDD::one();
@@ -15,14 +49,17 @@ MatrixDD buildFunctionality(const QuantumComputation* qc, Package<Config>& dd) {
   auto permutation = qc->initialLayout;
   auto e = dd.createInitialMatrix(nq, qc->ancillary);
 
+  OperationTraceRecorder trace(tracer, dd);
   for (const auto& op : *qc) {
-    auto tmp = dd.multiply(getDD(op.get(), dd, permutation), e);
+    trace.start(e);
+    auto tmp = applyUnitaryOperation(op.get(), e, dd, permutation);
 
     dd.incRef(tmp);
     dd.decRef(e);
     e = tmp;
 
     dd.garbageCollect();
+    trace.stop(*op, e);
   }
   // correct permutation if necessary
   changePermutation(e, permutation, qc->outputPermutation, dd);
@@ -116,6 +153,98 @@ bool buildFunctionalityRecursive(const QuantumComputation* qc,
   return success;
 }
 
+template <class Config>
+MatrixDD buildFunctionalityParallel(const QuantumComputation* qc,
+                                    Package<Config>& dd,
+                                    std::size_t numThreads) {
+  const auto nq = qc->getNqubits();
+  if (nq == 0U) {
+    return MatrixDD::one();
+  }
+
+  if (const auto* grover = dynamic_cast<const qc::Grover*>(qc)) {
+    return buildFunctionality(grover, dd);
+  }
+
+  if (numThreads == 0U) {
+    numThreads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  if (numThreads == 1U || qc->size() < 2U) {
+    return buildFunctionality(qc, dd);
+  }
+
+  // split the circuit into contiguous ranges of operations and determine the
+  // permutation at the start of every range
+  const auto numRanges = std::min(numThreads, qc->size());
+  const auto rangeSize = (qc->size() + numRanges - 1U) / numRanges;
+  std::vector<std::size_t> begins{};
+  std::vector<Permutation> permutations{};
+  auto permutation = qc->initialLayout;
+  for (std::size_t i = 0U; i < qc->size(); ++i) {
+    if (i % rangeSize == 0U) {
+      begins.emplace_back(i);
+      permutations.emplace_back(permutation);
+    }
+    updatePermutation(qc->at(i).get(), permutation);
+  }
+  begins.emplace_back(qc->size());
+
+  // construct the functionality of every range in its own package
+  const auto numLeaves = permutations.size();
+  std::vector<std::unique_ptr<Package<Config>>> packages(numLeaves);
+  std::vector<MatrixDD> results(numLeaves);
+  ThreadPool pool(numLeaves);
+  pool.parallelFor(numLeaves, [&](const std::size_t i) {
+    packages[i] = std::make_unique<Package<Config>>(nq);
+    auto& local = *packages[i];
+    local.adoptSettings(dd);
+    auto localPermutation = permutations[i];
+    auto e = i == 0U ? local.createInitialMatrix(nq, qc->ancillary)
+                     : local.makeIdent(nq);
+    if (i != 0U) {
+      local.incRef(e);
+    }
+    for (auto j = begins[i]; j < begins[i + 1U]; ++j) {
+      auto tmp = applyUnitaryOperation(qc->at(j).get(), e, local,
+                                       localPermutation);
+      local.incRef(tmp);
+      local.decRef(e);
+      e = tmp;
+      local.garbageCollect();
+    }
+    results[i] = e;
+  });
+
+  // multiply the partial results pairwise up a balanced binary tree. The
+  // product of every pair is computed in the package of the earlier range,
+  // into which the later result is transferred.
+  for (std::size_t stride = 1U; stride < numLeaves; stride *= 2U) {
+    const auto numPairs = (numLeaves + stride - 1U) / (2U * stride);
+    pool.parallelFor(numPairs, [&](const std::size_t pair) {
+      const auto i = 2U * stride * pair;
+      auto& local = *packages[i];
+      const auto later = local.transfer(results[i + stride]);
+      packages[i + stride].reset();
+      auto tmp = local.multiply(later, results[i]);
+      local.incRef(tmp);
+      local.decRef(results[i]);
+      results[i] = tmp;
+      local.garbageCollect();
+    });
+  }
+
+  auto e = dd.transfer(results.front());
+  dd.incRef(e);
+  packages.front().reset();
+
+  // correct permutation if necessary
+  changePermutation(e, permutation, qc->outputPermutation, dd);
+  e = dd.reduceAncillae(e, qc->ancillary);
+  e = dd.reduceGarbage(e, qc->garbage);
+
+  return e;
+}
+
 template <class Config>
 MatrixDD buildFunctionality(const qc::Grover* qc, Package<Config>& dd) {
   QuantumComputation groverIteration(qc->getNqubits());
@@ -198,7 +327,8 @@ MatrixDD buildFunctionalityRecursive(const qc::Grover* qc,
 }
 
 template MatrixDD buildFunctionality(const qc::QuantumComputation* qc,
-                                     Package<DDPackageConfig>& dd);
+                                     Package<DDPackageConfig>& dd,
+                                     OperationTracer* tracer);
 template MatrixDD buildFunctionalityRecursive(const qc::QuantumComputation* qc,
                                               Package<DDPackageConfig>& dd);
 template bool buildFunctionalityRecursive(const qc::QuantumComputation* qc,
@@ -207,6 +337,9 @@ template bool buildFunctionalityRecursive(const qc::QuantumComputation* qc,
                                           std::stack<MatrixDD>& s,
                                           qc::Permutation& permutation,
                                           Package<DDPackageConfig>& dd);
+template MatrixDD buildFunctionalityParallel(const qc::QuantumComputation* qc,
+                                             Package<DDPackageConfig>& dd,
+                                             std::size_t numThreads);
 template MatrixDD buildFunctionality(const qc::Grover* qc,
                                      Package<DDPackageConfig>& dd);
 template MatrixDD buildFunctionalityRecursive(const qc::Grover* qc,
@@ -1,13 +1,22 @@
 #include "dd/MemoryManager.hpp"
 
+#include "dd/Concurrency.hpp"
 #include "dd/Node.hpp"
 #include "dd/RealNumber.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <unordered_set>
+#include <vector>
 
 namespace dd {
 
 template <typename T> T* MemoryManager<T>::get() {
+  const auto lock = conditionalLock(mutex, concurrent);
   if (entryAvailableForReuse()) {
     return getEntryFromAvailableList();
   }
@@ -22,6 +31,7 @@ template <typename T> T* MemoryManager<T>::get() {
 template <typename T> void MemoryManager<T>::returnEntry(T* entry) noexcept {
   assert(entry != nullptr);
   assert(entry->ref == 0);
+  const auto lock = conditionalLock(mutex, concurrent);
   entry->next = available;
   available = entry;
   stats.trackReturnedEntry();
@@ -46,6 +56,134 @@ void MemoryManager<T>::reset(const bool resizeToTotal) noexcept {
   stats.numAllocated = chunks[0].size();
 }
 
+template <typename T> std::size_t MemoryManager<T>::releaseUnusedChunks() {
+  // the current chunk is kept, so there is nothing to release with one chunk
+  const auto numCandidates = chunks.size() - 1U;
+  if (numCandidates == 0U || !entryAvailableForReuse()) {
+    return 0U;
+  }
+
+  // sort the candidate chunks by address to find the chunk of an entry
+  std::vector<std::size_t> order(numCandidates);
+  std::iota(order.begin(), order.end(), 0U);
+  const std::less<const T*> before{};
+  std::sort(order.begin(), order.end(),
+            [this, &before](const std::size_t lhs, const std::size_t rhs) {
+              return before(chunks[lhs].data(), chunks[rhs].data());
+            });
+  const auto chunkOf = [this, &order, &before,
+                        numCandidates](const T* entry) -> std::size_t {
+    const auto it = std::upper_bound(
+        order.begin(), order.end(), entry,
+        [this, &before](const T* e, const std::size_t idx) {
+          return before(e, chunks[idx].data());
+        });
+    if (it == order.begin()) {
+      return numCandidates;
+    }
+    const auto idx = *std::prev(it);
+    const auto& chunk = chunks[idx];
+    return before(entry, chunk.data() + chunk.size()) ? idx : numCandidates;
+  };
+
+  // count the available entries per chunk
+  std::vector<std::size_t> numAvailable(numCandidates + 1U, 0U);
+  for (auto* entry = available; entry != nullptr; entry = entry->next) {
+    ++numAvailable[chunkOf(entry)];
+  }
+  std::vector<bool> release(numCandidates + 1U, false);
+  std::size_t numReleased = 0U;
+  for (std::size_t idx = 0U; idx < numCandidates; ++idx) {
+    if (numAvailable[idx] == chunks[idx].size()) {
+      release[idx] = true;
+      numReleased += chunks[idx].size();
+    }
+  }
+  if (numReleased == 0U) {
+    return 0U;
+  }
+
+  // unlink the entries of released chunks while preserving the list's order
+  T* head = nullptr;
+  T** tail = &head;
+  for (auto* entry = available; entry != nullptr; entry = entry->next) {
+    if (!release[chunkOf(entry)]) {
+      *tail = entry;
+      tail = &entry->next;
+    }
+  }
+  *tail = nullptr;
+  available = head;
+
+  // moving the chunks keeps their storage, but the iterators are re-derived
+  // to be on the safe side
+  const auto offset = std::distance(chunks.back().begin(), chunkIt);
+  std::vector<std::vector<T>> remaining{};
+  remaining.reserve(chunks.size());
+  for (std::size_t idx = 0U; idx < chunks.size(); ++idx) {
+    if (!release[idx]) {
+      remaining.emplace_back(std::move(chunks[idx]));
+    }
+  }
+  chunks = std::move(remaining);
+  chunkIt = chunks.back().begin() + offset;
+  chunkEndIt = chunks.back().end();
+
+  stats.numAllocated -= numReleased;
+  stats.numAvailableForReuse -= numReleased;
+  stats.reclaimedBytes += numReleased * sizeof(T);
+  return numReleased * sizeof(T);
+}
+
+template <typename T> Relocation<T> MemoryManager<T>::compact() {
+  const auto numAllocatedBefore = stats.numAllocated;
+  Relocation<T> relocation{};
+  if (stats.numUsed == 0U) {
+    // resetting the statistics must not lose track of earlier compactions
+    const auto numCompactions = stats.numCompactions;
+    const auto reclaimedBytes = stats.reclaimedBytes;
+    reset();
+    stats.numCompactions = numCompactions;
+    stats.reclaimedBytes = reclaimedBytes;
+  } else {
+    std::unordered_set<const T*> unused{};
+    unused.reserve(stats.numAvailableForReuse);
+    for (const auto* entry = available; entry != nullptr; entry = entry->next) {
+      unused.emplace(entry);
+    }
+
+    std::vector<T> dense(stats.numUsed);
+    relocation.reserve(stats.numUsed);
+    auto target = dense.begin();
+    for (auto& chunk : chunks) {
+      // entries behind `chunkIt` in the current chunk have never been used
+      const auto end = &chunk == &chunks.back() ? chunkIt : chunk.end();
+      for (auto it = chunk.begin(); it != end; ++it) {
+        if (unused.count(&*it) == 0U) {
+          *target = *it;
+          relocation.emplace(&*it, &*target);
+          ++target;
+        }
+      }
+    }
+    assert(target == dense.end());
+
+    chunks.clear();
+    chunks.emplace_back(std::move(dense));
+    chunkIt = chunks[0].end();
+    chunkEndIt = chunks[0].end();
+    available = nullptr;
+    ++stats.numAllocations;
+    stats.numAllocated = stats.numUsed;
+    stats.numAvailableForReuse = 0U;
+  }
+  ++stats.numCompactions;
+  stats.reclaimedBytes +=
+      (numAllocatedBefore - std::min(numAllocatedBefore, stats.numAllocated)) *
+      sizeof(T);
+  return relocation;
+}
+
 template <typename T>
 T* MemoryManager<T>::getEntryFromAvailableList() noexcept {
   assert(entryAvailableForReuse());
@@ -59,6 +197,9 @@ template <typename T> void MemoryManager<T>::allocateNewChunk() {
   assert(!entryAvailableInChunk());
   const auto newChunkSize = static_cast<std::size_t>(
       GROWTH_FACTOR * static_cast<double>(chunks.back().size()));
+  if (allocationGuard) {
+    allocationGuard(newChunkSize * sizeof(T));
+  }
   chunks.emplace_back(newChunkSize);
   chunkIt = chunks.back().begin();
   chunkEndIt = chunks.back().end();
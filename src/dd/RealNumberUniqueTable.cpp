@@ -1,10 +1,15 @@
 #include "dd/RealNumberUniqueTable.hpp"
 
+#include "dd/Concurrency.hpp"
+#include "dd/DDDefinitions.hpp"
 #include "dd/RealNumber.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <limits>
 
 namespace dd {
@@ -20,6 +25,19 @@ RealNumberUniqueTable::RealNumberUniqueTable(MemoryManager<RealNumber>& manager,
   lookupNonNegative(0.5L)->ref++;
 }
 
+namespace {
+/// The statically allocated entry for a non-negative number (if any)
+RealNumber* staticEntry(const fp val) noexcept {
+  if (RealNumber::approximatelyEquals(val, 1.0)) {
+    return &constants::one;
+  }
+  if (RealNumber::approximatelyEquals(val, SQRT2_2)) {
+    return &constants::sqrt2over2;
+  }
+  return nullptr;
+}
+} // namespace
+
 std::int64_t RealNumberUniqueTable::hash(const fp val) noexcept {
   static constexpr std::int64_t MASK = NBUCKET - 1;
   assert(val >= 0);
@@ -52,22 +70,71 @@ void RealNumberUniqueTable::decRef(RealNumber* num) noexcept {
   }
 }
 
+void RealNumberUniqueTable::lookup(const fp* vals, const std::size_t count,
+                                   RealNumber** results) {
+  // the real and imaginary parts of all edge weights of a matrix node
+  static constexpr std::size_t BATCH = 2U * NEDGE;
+  for (std::size_t offset = 0U; offset < count; offset += BATCH) {
+    const auto n = std::min(BATCH, count - offset);
+    std::array<fp, BATCH> mag{};
+    std::array<std::int64_t, BATCH> lowerKeys{};
+    std::array<std::int64_t, BATCH> upperKeys{};
+    for (std::size_t i = 0U; i < n; ++i) {
+      mag[i] = std::abs(vals[offset + i]);
+    }
+
+    std::array<RealNumber*, BATCH> entries{};
+    bool tableNeeded = false;
+    for (std::size_t i = 0U; i < n; ++i) {
+      entries[i] = RealNumber::approximatelyZero(mag[i])
+                       ? &constants::zero
+                       : staticEntry(mag[i]);
+      tableNeeded = tableNeeded || entries[i] == nullptr;
+    }
+    if (tableNeeded) {
+      // the keys are computed before the table is locked
+      for (std::size_t i = 0U; i < n; ++i) {
+        if (entries[i] == nullptr) {
+          lowerKeys[i] = hash(mag[i] - RealNumber::eps);
+          upperKeys[i] = hash(mag[i] + RealNumber::eps);
+        }
+      }
+      const auto lock = conditionalLock(mutex, concurrent);
+      for (std::size_t i = 0U; i < n; ++i) {
+        if (entries[i] == nullptr) {
+          entries[i] = lookupNonNegative(mag[i], lowerKeys[i], upperKeys[i]);
+        }
+      }
+    }
+
+    for (std::size_t i = 0U; i < n; ++i) {
+      results[offset + i] =
+          (entries[i] != &constants::zero && std::signbit(vals[offset + i]))
+              ? RealNumber::getNegativePointer(entries[i])
+              : entries[i];
+    }
+  }
+}
+
 RealNumber* RealNumberUniqueTable::lookupNonNegative(const fp val) {
   assert(!std::isnan(val));
   assert(val > 0);
 
-  if (RealNumber::approximatelyEquals(val, 1.0)) {
-    return &constants::one;
+  if (auto* entry = staticEntry(val); entry != nullptr) {
+    return entry;
   }
 
-  if (RealNumber::approximatelyEquals(val, SQRT2_2)) {
-    return &constants::sqrt2over2;
-  }
+  const auto lock = conditionalLock(mutex, concurrent);
+  return lookupNonNegative(val, hash(val - RealNumber::eps),
+                           hash(val + RealNumber::eps));
+}
 
-  ++stats.lookups;
-  const auto lowerKey = hash(val - RealNumber::eps);
-  const auto upperKey = hash(val + RealNumber::eps);
+RealNumber* RealNumberUniqueTable::lookupNonNegative(
+    const fp val, const std::int64_t lowerKey, const std::int64_t upperKey) {
+  assert(!std::isnan(val));
+  assert(val > 0);
 
+  ++stats.lookups;
   if (upperKey == lowerKey) {
     return findOrInsert(lowerKey, val);
   }
@@ -177,6 +244,19 @@ std::size_t RealNumberUniqueTable::garbageCollect(const bool force) noexcept {
   return entryCountBefore - stats.numEntries;
 }
 
+void RealNumberUniqueTable::relocate(const Relocation<RealNumber>& relocation) {
+  for (std::size_t key = 0; key < table.size(); ++key) {
+    RealNumber** link = &table[key];
+    RealNumber* lastp = nullptr;
+    while (*link != nullptr) {
+      lastp = relocation.at(*link);
+      *link = lastp;
+      link = &lastp->next;
+    }
+    tailTable[key] = lastp;
+  }
+}
+
 void RealNumberUniqueTable::clear() noexcept {
   // clear table buckets
   for (auto& bucket : table) {
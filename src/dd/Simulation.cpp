@@ -1,17 +1,160 @@
 #include "dd/Simulation.hpp"
 
 #include "dd/GateMatrixDefinitions.hpp"
+#include "dd/ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 namespace dd {
+namespace {
+/**
+ * @brief The number of shots simulated with the same random number generator
+ * by `simulateParallel`.
+ * @details Every batch of shots uses its own random number generator, which is
+ * derived from the seed and the index of the batch. Hence, the results only
+ * depend on the seed, but not on the number of threads or on which thread
+ * simulates which batch.
+ */
+constexpr std::size_t SHOTS_PER_BATCH = 16U;
+
+/**
+ * @brief Simulate a single shot of a (dynamic) circuit
+ * @details If tracing is enabled, every shot is traced separately.
+ * @returns The classical bits resulting from the shot.
+ */
 template <class Config>
-std::map<std::string, std::size_t>
-simulate(const QuantumComputation* qc, const VectorDD& in, Package<Config>& dd,
-         std::size_t shots, std::size_t seed) {
-  bool isDynamicCircuit = false;
-  bool hasMeasurements = false;
-  bool measurementsLast = true;
+std::string simulateShot(const QuantumComputation* qc, const VectorDD& in,
+                         Package<Config>& dd, std::mt19937_64& mt,
+                         OperationTraceRecorder<Config>& trace) {
+  std::map<std::size_t, char> measurements{};
 
-  std::mt19937_64 mt{};
+  auto permutation = qc->initialLayout;
+  auto e = in;
+  dd.incRef(e);
+
+  trace.restart(0U);
+  for (const auto& op : *qc) {
+    if (const auto* nonunitary = dynamic_cast<NonUnitaryOperation*>(op.get());
+        nonunitary != nullptr) {
+      if (nonunitary->getType() == Measure) {
+        trace.start(e);
+        const auto& qubits = nonunitary->getTargets();
+        const auto& bits = nonunitary->getClassics();
+        for (std::size_t j = 0U; j < qubits.size(); ++j) {
+          measurements[bits.at(j)] = dd.measureOneCollapsing(
+              e, static_cast<Qubit>(permutation.at(qubits.at(j))), true, mt);
+        }
+        trace.stop(*op, e);
+        continue;
+      }
+
+      if (nonunitary->getType() == Reset) {
+        trace.start(e);
+        const auto& qubits = nonunitary->getTargets();
+        for (const auto& qubit : qubits) {
+          auto bit = dd.measureOneCollapsing(
+              e, static_cast<Qubit>(permutation.at(qubit)), true, mt);
+          // apply an X operation whenever the measured result is one
+          if (bit == '1') {
+            auto tmp = dd.applyGate(
+                e, X_MAT, static_cast<Qubit>(permutation.at(qubit)));
+            dd.incRef(tmp);
+            dd.decRef(e);
+            e = tmp;
+            dd.garbageCollect();
+          }
+        }
+        trace.stop(*op, e);
+        continue;
+      }
+    }
+
+    if (const auto* classicControlled =
+            dynamic_cast<ClassicControlledOperation*>(op.get());
+        classicControlled != nullptr) {
+      const auto& controlRegister = classicControlled->getControlRegister();
+      const auto& expectedValue = classicControlled->getExpectedValue();
+      auto actualValue = 0ULL;
+      // determine the actual value from measurements
+      for (std::size_t j = 0; j < controlRegister.second; ++j) {
+        if (measurements[controlRegister.first + j] == '1') {
+          actualValue |= 1ULL << j;
+        }
+      }
+
+      // do not apply an operation if the value is not the expected one
+      if (actualValue != expectedValue) {
+        trace.skip();
+        continue;
+      }
+    }
+
+    trace.start(e);
+    auto tmp = applyUnitaryOperation(op.get(), e, dd, permutation);
+    dd.incRef(tmp);
+    dd.decRef(e);
+    e = tmp;
+
+    dd.garbageCollect();
+    trace.stop(*op, e);
+  }
+
+  // reduce reference count of measured state
+  dd.decRef(e);
+
+  std::string shot(qc->getNcbits(), '0');
+  for (const auto& [bit, value] : measurements) {
+    shot[qc->getNcbits() - bit - 1U] = value;
+  }
+  return shot;
+}
+
+/**
+ * @brief Apply an operation during an approximate simulation
+ * @details Applies the operation to the state and approximates the result if
+ * it exceeds the node threshold and the fidelity budget permits.
+ */
+template <class Config>
+void applyApproximately(const Operation* op, ApproximateSimulationResult& sim,
+                        Permutation& permutation, Package<Config>& dd,
+                        const ApproximationParameters& approximation) {
+  auto& e = sim.state;
+  auto tmp = applyUnitaryOperation(op, e, dd, permutation);
+  dd.incRef(tmp);
+  dd.decRef(e);
+  e = tmp;
+
+  // the number of nodes in the unique table bounds the size of the state
+  if (dd.vUniqueTable.getNumEntries() > approximation.nodeThreshold &&
+      e.size() > approximation.nodeThreshold) {
+    const auto target = std::max(approximation.stepFidelity,
+                                 approximation.finalFidelity / sim.fidelity);
+    if (target < 1.) {
+      const auto [approx, fidelity] = dd.approximate(e, target);
+      if (fidelity < 1.) {
+        dd.incRef(approx);
+        dd.decRef(e);
+        e = approx;
+        sim.fidelity *= fidelity;
+        ++sim.numApproximations;
+      }
+    }
+  }
+
+  dd.garbageCollect();
+}
+
+/// Seed a random number generator from the given seed or, if the seed is
+/// zero, from a random device
+void seedGenerator(std::mt19937_64& mt, const std::size_t seed) {
   if (seed != 0U) {
     mt.seed(seed);
   } else {
@@ -24,44 +167,189 @@ simulate(const QuantumComputation* qc, const VectorDD& in, Package<Config>& dd,
     std::seed_seq seeds(std::begin(randomData), std::end(randomData));
     mt.seed(seeds);
   }
-
-  std::map<qc::Qubit, std::size_t> measurementMap{};
-
-  // rudimentary check whether circuit is dynamic
+}
+/// Rudimentary check whether a circuit is dynamic, i.e., whether it can only
+/// be simulated shot by shot
+bool isDynamicCircuit(const QuantumComputation* qc) {
+  bool hasMeasurements = false;
   for (const auto& op : *qc) {
     // if it contains any dynamic circuit primitives, it certainly is dynamic
     if (op->isClassicControlledOperation() || op->getType() == qc::Reset) {
-      isDynamicCircuit = true;
-      break;
+      return true;
     }
-
-    // once a measurement is encountered we store the corresponding mapping
-    // (qubit -> bit)
-    if (const auto* measure = dynamic_cast<qc::NonUnitaryOperation*>(op.get());
-        measure != nullptr && measure->getType() == qc::Measure) {
+    // if an operation happens after a measurement, the resulting circuit can
+    // only be simulated in single shots
+    if (hasMeasurements && op->isUnitary()) {
+      return true;
+    }
+    if (op->getType() == qc::Measure) {
       hasMeasurements = true;
+    }
+  }
+  return false;
+}
 
-      const auto& quantum = measure->getTargets();
-      const auto& classic = measure->getClassics();
+/**
+ * @brief Simulate a number of shots of a (dynamic) circuit that share the same
+ * history
+ * @details All shots start from @p state at operation @p currentIt. The
+ * circuit is simulated until the next measurement or reset, where the shots
+ * are split binomially among the (at most two) possible outcomes. Each outcome
+ * is then simulated once for all of its shots.
+ * @param qc The circuit to simulate.
+ * @param currentState The current state. Its reference is consumed.
+ * @param currentIt The next operation to simulate.
+ * @param targetIdx The index of the next target of the current operation to
+ * measure or reset (operations may act on multiple qubits).
+ * @param permutation The current permutation.
+ * @param measurements The measurement results so far.
+ * @param shots The number of shots sharing this history.
+ * @param mt The random number generator.
+ * @param dd The package to use.
+ * @param counts The map to store the results in.
+ * @param trace The recorder tracing every branch separately.
+ */
+template <class Config>
+void simulateBranchingRecursive(
+    const QuantumComputation* qc, const VectorDD& currentState,
+    decltype(qc->begin()) currentIt, std::size_t targetIdx,
+    Permutation permutation, std::map<std::size_t, char> measurements,
+    const std::size_t shots, std::mt19937_64& mt, Package<Config>& dd,
+    std::map<std::string, std::size_t>& counts,
+    OperationTraceRecorder<Config>& trace) {
+  auto state = currentState;
+  trace.restart(
+      static_cast<std::size_t>(std::distance(qc->begin(), currentIt)));
+  for (auto it = currentIt; it != qc->end(); ++it, targetIdx = 0U) {
+    const auto& op = (*it);
 
-      for (std::size_t i = 0; i < quantum.size(); ++i) {
-        measurementMap[quantum.at(i)] = classic.at(i);
+    if (const auto* classicControlled =
+            dynamic_cast<ClassicControlledOperation*>(op.get());
+        classicControlled != nullptr) {
+      const auto& controlRegister = classicControlled->getControlRegister();
+      const auto& expectedValue = classicControlled->getExpectedValue();
+      auto actualValue = 0ULL;
+      // determine the actual value from measurements
+      for (std::size_t j = 0; j < controlRegister.second; ++j) {
+        if (measurements[controlRegister.first + j] == '1') {
+          actualValue |= 1ULL << j;
+        }
+      }
+
+      // do not apply an operation if the value is not the expected one
+      if (actualValue != expectedValue) {
+        trace.skip();
+        continue;
       }
     }
 
-    // if an operation happens after a measurement, the resulting circuit can
-    // only be simulated in single shots
-    if (hasMeasurements &&
-        (op->isUnitary() || op->isClassicControlledOperation())) {
-      measurementsLast = false;
+    // measurements and resets form the branching points of the simulation
+    if (const auto* nonunitary = dynamic_cast<NonUnitaryOperation*>(op.get());
+        nonunitary != nullptr && (nonunitary->getType() == Measure ||
+                                  nonunitary->getType() == Reset)) {
+      const auto& targets = nonunitary->getTargets();
+      if (targetIdx == targets.size()) {
+        trace.skip();
+        continue;
+      }
+      const auto isMeasurement = nonunitary->getType() == Measure;
+      const auto target =
+          static_cast<Qubit>(permutation.at(targets.at(targetIdx)));
+
+      auto [pzero, pone] =
+          dd.determineMeasurementProbabilities(state, target, true);
+      const auto norm = pzero + pone;
+      pzero /= norm;
+      pone /= norm;
+
+      // distribute the shots among both outcomes
+      std::binomial_distribution<std::size_t> dist(shots, pzero);
+      const auto shotsZero = dist(mt);
+      const auto shotsOne = shots - shotsZero;
+
+      // in case both outcomes occur the reference count of the state has to be
+      // increased once more in order to avoid reference counting errors
+      if (shotsZero > 0U && shotsOne > 0U) {
+        dd.incRef(state);
+      }
+
+      for (const auto outcome : {'0', '1'}) {
+        const auto branchShots = outcome == '0' ? shotsZero : shotsOne;
+        if (branchShots == 0U) {
+          continue;
+        }
+        auto branchMeasurements = measurements;
+        if (isMeasurement) {
+          branchMeasurements[nonunitary->getClassics().at(targetIdx)] =
+              outcome;
+        }
+        auto branchState = state;
+        dd.performCollapsingMeasurement(
+            branchState, target, outcome == '0' ? pzero : pone,
+            outcome == '0');
+        // a reset applies an X operation whenever the measured result is one
+        if (!isMeasurement && outcome == '1') {
+          auto tmp = dd.applyGate(branchState, X_MAT, target);
+          dd.incRef(tmp);
+          dd.decRef(branchState);
+          branchState = tmp;
+          dd.garbageCollect();
+        }
+        simulateBranchingRecursive(qc, branchState, it, targetIdx + 1U,
+                                   permutation, branchMeasurements,
+                                   branchShots, mt, dd, counts, trace);
+      }
+      return;
     }
+
+    trace.start(state);
+    auto tmp = applyUnitaryOperation(op.get(), state, dd, permutation);
+    dd.incRef(tmp);
+    dd.decRef(state);
+    state = tmp;
+
+    dd.garbageCollect();
+    trace.stop(*op, state);
   }
 
-  if (!measurementsLast) {
-    isDynamicCircuit = true;
+  // all shots sharing this history yield the same classical bits
+  dd.decRef(state);
+  std::string shot(qc->getNcbits(), '0');
+  for (const auto& [bit, value] : measurements) {
+    shot[qc->getNcbits() - bit - 1U] = value;
   }
+  counts[shot] += shots;
+}
+} // namespace
+
+template <class Config>
+std::map<std::string, std::size_t>
+simulate(const QuantumComputation* qc, const VectorDD& in, Package<Config>& dd,
+         std::size_t shots, std::size_t seed, OperationTracer* tracer) {
+  std::mt19937_64 mt{};
+  seedGenerator(mt, seed);
+  OperationTraceRecorder trace(tracer, dd);
+
+  if (!isDynamicCircuit(qc)) {
+    // once a measurement is encountered we store the corresponding mapping
+    // (qubit -> bit)
+    bool hasMeasurements = false;
+    std::map<qc::Qubit, std::size_t> measurementMap{};
+    for (const auto& op : *qc) {
+      if (const auto* measure =
+              dynamic_cast<qc::NonUnitaryOperation*>(op.get());
+          measure != nullptr && measure->getType() == qc::Measure) {
+        hasMeasurements = true;
+
+        const auto& quantum = measure->getTargets();
+        const auto& classic = measure->getClassics();
+
+        for (std::size_t i = 0; i < quantum.size(); ++i) {
+          measurementMap[quantum.at(i)] = classic.at(i);
+        }
+      }
+    }
 
-  if (!isDynamicCircuit) {
     // if all gates are unitary (besides measurements at the end), we just
     // simulate once and measure all qubits repeatedly
     auto permutation = qc->initialLayout;
@@ -71,28 +359,27 @@ simulate(const QuantumComputation* qc, const VectorDD& in, Package<Config>& dd,
     for (const auto& op : *qc) {
       // simply skip any non-unitary
       if (!op->isUnitary()) {
+        trace.skip();
         continue;
       }
 
-      auto tmp = dd.multiply(getDD(op.get(), dd, permutation), e);
+      trace.start(e);
+      auto tmp = applyUnitaryOperation(op.get(), e, dd, permutation);
       dd.incRef(tmp);
       dd.decRef(e);
       e = tmp;
 
       dd.garbageCollect();
+      trace.stop(*op, e);
     }
 
     // correct permutation if necessary
     changePermutation(e, permutation, qc->outputPermutation, dd);
     e = dd.reduceGarbage(e, qc->garbage);
 
-    // measure all qubits
-    std::map<std::string, std::size_t> counts{};
-    for (std::size_t i = 0U; i < shots; ++i) {
-      // measure all returns a string of the form "q(n-1) ... q(0)"
-      auto measurement = dd.measureAll(e, false, mt);
-      counts.operator[](measurement) += 1U;
-    }
+    // sample all qubits at once. The outcomes are strings of the form
+    // "q(n-1) ... q(0)"
+    const auto counts = dd.sampleAll(e, shots, mt);
     // reduce reference count of measured state
     dd.decRef(e);
 
@@ -123,84 +410,89 @@ simulate(const QuantumComputation* qc, const VectorDD& in, Package<Config>& dd,
   }
 
   std::map<std::string, std::size_t> counts{};
-
   for (std::size_t i = 0U; i < shots; i++) {
-    std::map<std::size_t, char> measurements{};
-
-    auto permutation = qc->initialLayout;
-    auto e = in;
-    dd.incRef(e);
-
-    for (const auto& op : *qc) {
-      if (const auto* nonunitary = dynamic_cast<NonUnitaryOperation*>(op.get());
-          nonunitary != nullptr) {
-        if (nonunitary->getType() == Measure) {
-          const auto& qubits = nonunitary->getTargets();
-          const auto& bits = nonunitary->getClassics();
-          for (std::size_t j = 0U; j < qubits.size(); ++j) {
-            measurements[bits.at(j)] = dd.measureOneCollapsing(
-                e, static_cast<Qubit>(permutation.at(qubits.at(j))), true, mt);
-          }
-          continue;
-        }
+    counts[simulateShot(qc, in, dd, mt, trace)]++;
+  }
 
-        if (nonunitary->getType() == Reset) {
-          const auto& qubits = nonunitary->getTargets();
-          for (const auto& qubit : qubits) {
-            auto bit = dd.measureOneCollapsing(
-                e, static_cast<Qubit>(permutation.at(qubit)), true, mt);
-            // apply an X operation whenever the measured result is one
-            if (bit == '1') {
-              const auto x = qc::StandardOperation(
-                  qc->getNqubits(), permutation.at(qubit), qc::X);
-              auto tmp = dd.multiply(getDD(&x, dd), e);
-              dd.incRef(tmp);
-              dd.decRef(e);
-              e = tmp;
-              dd.garbageCollect();
-            }
-          }
-          continue;
-        }
-      }
+  return counts;
+}
 
-      if (const auto* classicControlled =
-              dynamic_cast<ClassicControlledOperation*>(op.get());
-          classicControlled != nullptr) {
-        const auto& controlRegister = classicControlled->getControlRegister();
-        const auto& expectedValue = classicControlled->getExpectedValue();
-        auto actualValue = 0ULL;
-        // determine the actual value from measurements
-        for (std::size_t j = 0; j < controlRegister.second; ++j) {
-          if (measurements[controlRegister.first + j] == '1') {
-            actualValue |= 1ULL << j;
-          }
-        }
+template <class Config>
+std::map<std::string, std::size_t>
+simulateParallel(const QuantumComputation* qc, const VectorDD& in,
+                 Package<Config>& dd, const std::size_t shots,
+                 std::size_t seed, std::size_t numThreads,
+                 OperationTracer* tracer) {
+  if (!isDynamicCircuit(qc)) {
+    // the state only has to be computed once and can be sampled afterwards
+    return simulate(qc, in, dd, shots, seed, tracer);
+  }
+  if (tracer != nullptr) {
+    throw std::invalid_argument(
+        "Tracing is not supported for the parallel simulation of dynamic "
+        "circuits.");
+  }
 
-        // do not apply an operation if the value is not the expected one
-        if (actualValue != expectedValue) {
-          continue;
-        }
+  if (seed == 0U) {
+    std::random_device rd;
+    seed = (static_cast<std::uint64_t>(rd()) << 32U) | rd();
+  }
+  if (numThreads == 0U) {
+    numThreads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  const auto numBatches = (shots + SHOTS_PER_BATCH - 1U) / SHOTS_PER_BATCH;
+  numThreads = std::min(numThreads, numBatches);
+
+  std::atomic<std::size_t> nextBatch{0U};
+  std::vector<std::map<std::string, std::size_t>> threadCounts(numThreads);
+  ThreadPool pool(numThreads);
+  pool.parallelFor(numThreads, [&](const std::size_t t) {
+    // every worker uses its own package and a copy of the input state
+    auto localDD = std::make_unique<Package<Config>>(dd.qubits());
+    localDD->adoptSettings(dd);
+    OperationTraceRecorder<Config> trace(nullptr, *localDD);
+    auto original = in;
+    const auto localIn = localDD->transfer(original);
+    localDD->incRef(localIn);
+
+    for (auto batch = nextBatch++; batch < numBatches; batch = nextBatch++) {
+      std::seed_seq seeds{seed & 0xFFFFFFFFU, seed >> 32U, batch & 0xFFFFFFFFU,
+                          batch >> 32U};
+      std::mt19937_64 mt(seeds);
+      const auto end = std::min(shots, (batch + 1U) * SHOTS_PER_BATCH);
+      for (auto i = batch * SHOTS_PER_BATCH; i < end; ++i) {
+        threadCounts[t][simulateShot(qc, localIn, *localDD, mt, trace)]++;
       }
-
-      auto tmp = dd.multiply(getDD(op.get(), dd, permutation), e);
-      dd.incRef(tmp);
-      dd.decRef(e);
-      e = tmp;
-
-      dd.garbageCollect();
     }
+    localDD->decRef(localIn);
+  });
 
-    // reduce reference count of measured state
-    dd.decRef(e);
-
-    std::string shot(qc->getNcbits(), '0');
-    for (const auto& [bit, value] : measurements) {
-      shot[qc->getNcbits() - bit - 1U] = value;
+  std::map<std::string, std::size_t> counts{};
+  for (const auto& local : threadCounts) {
+    for (const auto& [shot, count] : local) {
+      counts[shot] += count;
     }
-    counts[shot]++;
   }
+  return counts;
+}
+
+template <class Config>
+std::map<std::string, std::size_t>
+simulateBranching(const QuantumComputation* qc, const VectorDD& in,
+                  Package<Config>& dd, const std::size_t shots,
+                  const std::size_t seed, OperationTracer* tracer) {
+  std::mt19937_64 mt{};
+  seedGenerator(mt, seed);
 
+  std::map<std::string, std::size_t> counts{};
+  if (shots == 0U) {
+    return counts;
+  }
+  dd.incRef(in);
+  OperationTraceRecorder trace(tracer, dd);
+  simulateBranchingRecursive(qc, in, qc->begin(), 0U, qc->initialLayout,
+                             std::map<std::size_t, char>{}, shots, mt, dd,
+                             counts, trace);
   return counts;
 }
 
@@ -400,7 +692,7 @@ void extractProbabilityVectorRecursive(const QuantumComputation* qc,
     }
 
     // any standard operation or classic-controlled operation is applied here
-    auto tmp = dd.multiply(getDD(op.get(), dd, permutation), state);
+    auto tmp = applyUnitaryOperation(op.get(), state, dd, permutation);
     dd.incRef(tmp);
     dd.decRef(state);
     state = tmp;
@@ -422,7 +714,7 @@ VectorDD simulate(GoogleRandomCircuitSampling* qc, const VectorDD& in,
   dd.incRef(e);
   for (const auto& cycle : qc->cycles) {
     for (const auto& op : cycle) {
-      auto tmp = dd.multiply(getDD(op.get(), dd, permutation), e);
+      auto tmp = applyUnitaryOperation(op.get(), e, dd, permutation);
       dd.incRef(tmp);
       dd.decRef(e);
       e = tmp;
@@ -432,10 +724,61 @@ VectorDD simulate(GoogleRandomCircuitSampling* qc, const VectorDD& in,
   return e;
 }
 
+template <class Config>
+ApproximateSimulationResult
+simulate(const QuantumComputation* qc, const VectorDD& in, Package<Config>& dd,
+         const ApproximationParameters& approximation,
+         OperationTracer* tracer) {
+  // measurements are currently not supported here
+  auto permutation = qc->initialLayout;
+  ApproximateSimulationResult sim{in};
+  dd.incRef(sim.state);
+
+  OperationTraceRecorder trace(tracer, dd);
+  for (const auto& op : *qc) {
+    trace.start(sim.state);
+    applyApproximately(op.get(), sim, permutation, dd, approximation);
+    trace.stop(*op, sim.state);
+  }
+
+  // correct permutation if necessary
+  changePermutation(sim.state, permutation, qc->outputPermutation, dd);
+  sim.state = dd.reduceGarbage(sim.state, qc->garbage);
+  return sim;
+}
+
+template <class Config>
+ApproximateSimulationResult
+simulate(GoogleRandomCircuitSampling* qc, const VectorDD& in,
+         Package<Config>& dd, const ApproximationParameters& approximation,
+         const std::optional<std::size_t> ncycles) {
+  if (ncycles.has_value() && (*ncycles < qc->cycles.size() - 2U)) {
+    qc->removeCycles(qc->cycles.size() - 2U - *ncycles);
+  }
+
+  Permutation permutation = qc->initialLayout;
+  ApproximateSimulationResult sim{in};
+  dd.incRef(sim.state);
+  for (const auto& cycle : qc->cycles) {
+    for (const auto& op : cycle) {
+      applyApproximately(op.get(), sim, permutation, dd, approximation);
+    }
+  }
+  return sim;
+}
+
 template std::map<std::string, std::size_t>
 simulate<DDPackageConfig>(const QuantumComputation* qc, const VectorDD& in,
                           Package<DDPackageConfig>& dd, std::size_t shots,
-                          std::size_t seed);
+                          std::size_t seed, OperationTracer* tracer);
+template std::map<std::string, std::size_t> simulateParallel<DDPackageConfig>(
+    const QuantumComputation* qc, const VectorDD& in,
+    Package<DDPackageConfig>& dd, std::size_t shots, std::size_t seed,
+    std::size_t numThreads, OperationTracer* tracer);
+template std::map<std::string, std::size_t> simulateBranching<DDPackageConfig>(
+    const QuantumComputation* qc, const VectorDD& in,
+    Package<DDPackageConfig>& dd, std::size_t shots, std::size_t seed,
+    OperationTracer* tracer);
 template void extractProbabilityVector<DDPackageConfig>(
     const QuantumComputation* qc, const VectorDD& in, SparsePVec& probVector,
     Package<DDPackageConfig>& dd);
@@ -448,4 +791,14 @@ template VectorDD
 simulate<DDPackageConfig>(GoogleRandomCircuitSampling* qc, const VectorDD& in,
                           Package<DDPackageConfig>& dd,
                           const std::optional<std::size_t> ncycles);
+template ApproximateSimulationResult
+simulate<DDPackageConfig>(const QuantumComputation* qc, const VectorDD& in,
+                          Package<DDPackageConfig>& dd,
+                          const ApproximationParameters& approximation,
+                          OperationTracer* tracer);
+template ApproximateSimulationResult
+simulate<DDPackageConfig>(GoogleRandomCircuitSampling* qc, const VectorDD& in,
+                          Package<DDPackageConfig>& dd,
+                          const ApproximationParameters& approximation,
+                          const std::optional<std::size_t> ncycles);
 } // namespace dd
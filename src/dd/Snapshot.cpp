@@ -0,0 +1,139 @@
+#include "dd/Snapshot.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace dd {
+
+namespace {
+/// Round up to the next multiple of eight bytes
+std::size_t alignColumn(const std::size_t offset) {
+  return (offset + 7U) & ~static_cast<std::size_t>(7U);
+}
+} // namespace
+
+Snapshot::Snapshot(const std::byte* data, const std::size_t size) {
+  if (data == nullptr || size < SNAPSHOT_HEADER_SIZE ||
+      !std::equal(SNAPSHOT_MAGIC.begin(), SNAPSHOT_MAGIC.end(), data,
+                  [](const char c, const std::byte b) {
+                    return static_cast<std::byte>(c) == b;
+                  })) {
+    throw std::runtime_error("Data is not a DD snapshot.");
+  }
+
+  const auto version = load<std::uint32_t>(data + 8U);
+  if (version != SNAPSHOT_VERSION) {
+    throw std::runtime_error(
+        "Unsupported snapshot version. version of snapshot: " +
+        std::to_string(version) +
+        "; current version: " + std::to_string(SNAPSHOT_VERSION));
+  }
+
+  const auto kind = load<std::uint32_t>(data + 12U);
+  numEdges = load<std::uint32_t>(data + 16U);
+  if (kind == static_cast<std::uint32_t>(SnapshotKind::Vector) &&
+      numEdges == RADIX) {
+    ddKind = SnapshotKind::Vector;
+  } else if (kind == static_cast<std::uint32_t>(SnapshotKind::Matrix) &&
+             numEdges == NEDGE) {
+    ddKind = SnapshotKind::Matrix;
+  } else {
+    throw std::runtime_error("Snapshot contains an unknown kind of DD.");
+  }
+
+  const auto numNodes64 = load<std::uint64_t>(data + 24U);
+  const auto numWeights64 = load<std::uint64_t>(data + 32U);
+  if (numNodes64 >= NO_NODE || numWeights64 > NO_NODE) {
+    throw std::runtime_error("Snapshot header is corrupted.");
+  }
+  nodes = static_cast<std::size_t>(numNodes64);
+  weights = static_cast<std::size_t>(numWeights64);
+  rootNode = load<std::uint32_t>(data + 40U);
+  rootWeightIndex = load<std::uint32_t>(data + 44U);
+
+  // determine the offsets of the columns
+  const auto numEdgesTotal = nodes * numEdges;
+  const auto variablesOffset = SNAPSHOT_HEADER_SIZE;
+  const auto childrenOffset =
+      alignColumn(variablesOffset + (nodes * sizeof(Qubit)));
+  const auto edgeWeightsOffset =
+      alignColumn(childrenOffset + (numEdgesTotal * sizeof(std::uint32_t)));
+  const auto weightTableOffset = alignColumn(
+      edgeWeightsOffset + (numEdgesTotal * sizeof(std::uint32_t)));
+  const auto expectedSize =
+      weightTableOffset + (weights * 2U * sizeof(std::uint64_t));
+  if (size < expectedSize) {
+    throw std::runtime_error("Snapshot is truncated. Expected " +
+                             std::to_string(expectedSize) + " bytes, got " +
+                             std::to_string(size) + ".");
+  }
+  if (rootWeightIndex >= weights ||
+      (rootNode != NO_NODE && rootNode >= nodes)) {
+    throw std::runtime_error("Snapshot header is corrupted.");
+  }
+
+  variables = data + variablesOffset;
+  children = data + childrenOffset;
+  edgeWeights = data + edgeWeightsOffset;
+  weightTable = data + weightTableOffset;
+}
+
+#ifndef _WIN32
+MappedFile::MappedFile(const std::string& filename) {
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::invalid_argument("Cannot open file: " + filename);
+  }
+  struct stat info {};
+  if (::fstat(fd, &info) != 0) {
+    ::close(fd);
+    throw std::invalid_argument("Cannot determine size of file: " + filename);
+  }
+  length = static_cast<std::size_t>(info.st_size);
+  if (length > 0U) {
+    void* mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("Cannot map file into memory: " + filename);
+    }
+    contents = static_cast<const std::byte*>(mapping);
+  }
+  // the mapping stays valid after the file descriptor has been closed
+  ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (contents != nullptr && buffer.empty()) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    ::munmap(const_cast<std::byte*>(contents), length);
+  }
+}
+#else
+MappedFile::MappedFile(const std::string& filename) {
+  std::ifstream ifs(filename, std::ios::binary | std::ios::ate);
+  if (!ifs.good()) {
+    throw std::invalid_argument("Cannot open file: " + filename);
+  }
+  length = static_cast<std::size_t>(ifs.tellg());
+  buffer.resize(length);
+  ifs.seekg(0);
+  ifs.read(reinterpret_cast<char*>(buffer.data()),
+           static_cast<std::streamsize>(length));
+  contents = buffer.data();
+}
+
+MappedFile::~MappedFile() = default;
+#endif
+
+} // namespace dd
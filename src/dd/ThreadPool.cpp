@@ -0,0 +1,124 @@
+#include "dd/ThreadPool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace dd {
+
+namespace {
+/// The pool the calling thread is a worker of (if any)
+thread_local const ThreadPool* currentPool = nullptr;
+/// The index of the calling thread within its pool
+thread_local std::size_t currentIndex = 0U;
+} // namespace
+
+ThreadPool::ThreadPool(std::size_t numThreads) {
+  if (numThreads == 0U) {
+    numThreads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  queues.reserve(numThreads + 1U);
+  for (std::size_t i = 0U; i <= numThreads; ++i) {
+    queues.emplace_back(std::make_unique<TaskQueue>());
+  }
+  workers.reserve(numThreads);
+  for (std::size_t i = 0U; i < numThreads; ++i) {
+    workers.emplace_back([this, i]() { workerLoop(i); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    const std::lock_guard lock(sleepMutex);
+    stop = true;
+  }
+  wakeup.notify_all();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+std::size_t ThreadPool::queueIndex() const noexcept {
+  if (currentPool == this) {
+    return currentIndex;
+  }
+  return workers.size();
+}
+
+void ThreadPool::push(Task task) {
+  auto& queue = *queues[queueIndex()];
+  {
+    // the task has to be counted before any other thread can take it from
+    // the queue (and decrement the counter again). Holding the sleep mutex
+    // ensures that workers about to sleep do not miss the new task.
+    const std::lock_guard sleepLock(sleepMutex);
+    const std::lock_guard queueLock(queue.mutex);
+    ++numPending;
+    queue.tasks.emplace_back(std::move(task));
+  }
+  wakeup.notify_one();
+}
+
+std::optional<ThreadPool::Task> ThreadPool::popBack(const std::size_t idx) {
+  auto& queue = *queues[idx];
+  const std::lock_guard lock(queue.mutex);
+  if (queue.tasks.empty()) {
+    return std::nullopt;
+  }
+  auto task = std::move(queue.tasks.back());
+  queue.tasks.pop_back();
+  --numPending;
+  return task;
+}
+
+std::optional<ThreadPool::Task> ThreadPool::steal(const std::size_t idx) {
+  const auto numQueues = queues.size();
+  for (std::size_t offset = 1U; offset < numQueues; ++offset) {
+    auto& queue = *queues[(idx + offset) % numQueues];
+    const std::lock_guard lock(queue.mutex);
+    if (queue.tasks.empty()) {
+      continue;
+    }
+    auto task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    --numPending;
+    return task;
+  }
+  return std::nullopt;
+}
+
+bool ThreadPool::runPendingTask() {
+  if (numPending == 0U) {
+    return false;
+  }
+  const auto idx = queueIndex();
+  auto task = popBack(idx);
+  if (!task.has_value()) {
+    task = steal(idx);
+  }
+  if (!task.has_value()) {
+    return false;
+  }
+  (*task)();
+  return true;
+}
+
+void ThreadPool::workerLoop(const std::size_t idx) {
+  currentPool = this;
+  currentIndex = idx;
+  while (true) {
+    if (runPendingTask()) {
+      continue;
+    }
+    std::unique_lock lock(sleepMutex);
+    wakeup.wait(lock, [this]() { return stop || numPending > 0U; });
+    if (stop) {
+      return;
+    }
+  }
+}
+
+} // namespace dd
@@ -0,0 +1,63 @@
+#include "dd/statistics/ComputeTableStatistics.hpp"
+
+#include "nlohmann/json.hpp"
+
+#include <string>
+
+namespace dd {
+
+void ComputeTableStatistics::setNumWays(const std::size_t ways) {
+  numWays = ways;
+  hitsPerWay.assign(ways, 0U);
+}
+
+void ComputeTableStatistics::trackCollection(
+    const std::size_t invalidated) noexcept {
+  if (gcRuns == 0U) {
+    hitsBeforeGC = hits;
+    lookupsBeforeGC = lookups;
+  }
+  ++gcRuns;
+  gcInvalidations += invalidated;
+  numEntries -= invalidated;
+  gcRetentions += numEntries;
+}
+
+double ComputeTableStatistics::hitRatioBeforeGC() const noexcept {
+  const auto numLookups = gcRuns == 0U ? lookups : lookupsBeforeGC;
+  if (numLookups == 0U) {
+    return 1.;
+  }
+  const auto numHits = gcRuns == 0U ? hits : hitsBeforeGC;
+  return static_cast<double>(numHits) / static_cast<double>(numLookups);
+}
+
+double ComputeTableStatistics::hitRatioAfterGC() const noexcept {
+  if (gcRuns == 0U || lookups == lookupsBeforeGC) {
+    return 1.;
+  }
+  return static_cast<double>(hits - hitsBeforeGC) /
+         static_cast<double>(lookups - lookupsBeforeGC);
+}
+
+nlohmann::json ComputeTableStatistics::json() const {
+  if (lookups == 0) {
+    return "unused";
+  }
+
+  nlohmann::json j = TableStatistics::json();
+  j["num_ways"] = numWays;
+  j["evictions"] = evictions;
+  j["gc_runs"] = gcRuns;
+  j["gc_invalidations"] = gcInvalidations;
+  j["gc_retentions"] = gcRetentions;
+  j["hit_ratio_before_gc"] = hitRatioBeforeGC();
+  j["hit_ratio_after_gc"] = hitRatioAfterGC();
+  auto& perWay = j["hits_per_way"];
+  for (std::size_t way = 0U; way < hitsPerWay.size(); ++way) {
+    perWay[std::to_string(way)] = hitsPerWay[way];
+  }
+  return j;
+}
+
+} // namespace dd
@@ -24,6 +24,21 @@ double MemoryManagerStatistics<T>::getUsageRatio() const noexcept {
   return static_cast<double>(numUsed) / static_cast<double>(numAllocated);
 }
 
+template <typename T>
+double MemoryManagerStatistics<T>::getFragmentation() const noexcept {
+  if (numAllocated == 0U) {
+    return 0.;
+  }
+  return static_cast<double>(numAvailableForReuse) /
+         static_cast<double>(numAllocated);
+}
+
+template <typename T>
+double MemoryManagerStatistics<T>::getReclaimedMemoryMiB() const noexcept {
+  return static_cast<double>(reclaimedBytes) /
+         static_cast<double>(1ULL << 20U);
+}
+
 template <typename T>
 double MemoryManagerStatistics<T>::getAllocatedMemoryMiB() const noexcept {
   return static_cast<double>(numAllocated) * ENTRY_MEMORY_MIB;
@@ -87,6 +102,9 @@ template <typename T> nlohmann::json MemoryManagerStatistics<T>::json() const {
   j["num_used"] = numUsed;
   j["num_used_peak"] = peakNumUsed;
   j["usage_ratio"] = getUsageRatio();
+  j["fragmentation"] = getFragmentation();
+  j["num_compactions"] = numCompactions;
+  j["memory_reclaimed_MiB"] = getReclaimedMemoryMiB();
   return j;
 }
 
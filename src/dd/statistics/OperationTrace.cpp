@@ -0,0 +1,48 @@
+#include "dd/statistics/OperationTrace.hpp"
+
+#include "nlohmann/json.hpp"
+
+#include <cstddef>
+#include <ostream>
+
+namespace dd {
+
+nlohmann::json OperationTraceEvent::json() const {
+  nlohmann::json j;
+  j[FIELDS[0]] = index;
+  j[FIELDS[1]] = operation;
+  j[FIELDS[2]] = runtime;
+  j[FIELDS[3]] = nodesBefore;
+  j[FIELDS[4]] = nodesAfter;
+  j[FIELDS[5]] = computeTableLookups;
+  j[FIELDS[6]] = computeTableHits;
+  j[FIELDS[7]] = collectedVectorNodes;
+  j[FIELDS[8]] = collectedMatrixNodes;
+  j[FIELDS[9]] = collectedDensityMatrixNodes;
+  j[FIELDS[10]] = collectedRealNumbers;
+  j[FIELDS[11]] = allocatedMemoryMiB;
+  j[FIELDS[12]] = allocatedMemoryGrowthMiB;
+  return j;
+}
+
+void JSONTraceWriter::record(const OperationTraceEvent& event) {
+  *os << event.json().dump() << "\n";
+}
+
+void CSVTraceWriter::record(const OperationTraceEvent& event) {
+  if (!headerWritten) {
+    for (std::size_t i = 0U; i < OperationTraceEvent::FIELDS.size(); ++i) {
+      *os << (i == 0U ? "" : ",") << OperationTraceEvent::FIELDS[i];
+    }
+    *os << "\n";
+    headerWritten = true;
+  }
+  // the JSON representation takes care of formatting the values
+  const auto j = event.json();
+  for (std::size_t i = 0U; i < OperationTraceEvent::FIELDS.size(); ++i) {
+    *os << (i == 0U ? "" : ",") << j[OperationTraceEvent::FIELDS[i]].dump();
+  }
+  *os << "\n";
+}
+
+} // namespace dd
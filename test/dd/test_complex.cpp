@@ -447,6 +447,33 @@ TEST_F(CNTest, ComplexTableAllocation) {
   EXPECT_EQ(entry, entry2);
 }
 
+TEST_F(CNTest, CompactEmptyMemoryManager) {
+  auto mem = MemoryManager<RealNumber>{};
+  const auto allocs = mem.getStats().numAllocated;
+  // grow the manager beyond its initial chunk and return all entries
+  std::vector<RealNumber*> nums(allocs + 1U);
+  for (auto& num : nums) {
+    num = mem.get();
+  }
+  for (auto* num : nums) {
+    mem.returnEntry(num);
+  }
+  const auto allocated = mem.getStats().numAllocated;
+  ASSERT_GT(allocated, allocs);
+
+  const auto& stats = mem.getStats();
+  EXPECT_TRUE(mem.compact().empty());
+  EXPECT_EQ(stats.numCompactions, 1U);
+  EXPECT_EQ(stats.numAllocated, allocs);
+  EXPECT_EQ(stats.reclaimedBytes, (allocated - allocs) * sizeof(RealNumber));
+
+  // compacting again reclaims nothing, but keeps the earlier statistics
+  EXPECT_TRUE(mem.compact().empty());
+  EXPECT_EQ(stats.numCompactions, 2U);
+  EXPECT_EQ(stats.numAllocated, allocs);
+  EXPECT_EQ(stats.reclaimedBytes, (allocated - allocs) * sizeof(RealNumber));
+}
+
 TEST_F(CNTest, DoubleHitInFindOrInsert) {
   // insert a number somewhere in a bucket
   const fp num1 = 0.5;
@@ -547,3 +574,37 @@ TEST_F(CNTest, ExportConditionalFormat7) {
   EXPECT_STREQ(dd::conditionalFormat(cn.lookup(-dd::SQRT2_2, 0)).c_str(),
                "-1/√2");
 }
+
+TEST_F(CNTest, BatchedLookup) {
+  // more values than are processed at once
+  const std::array<ComplexValue, 6U> values{
+      ComplexValue{0.3, -0.3},
+      {0., 1.},
+      {-SQRT2_2, 1e-16},
+      {0.25, 0.25 + (RealNumber::eps / 10.)},
+      {-0.7, 0.123},
+      {1e-20, -1.}};
+  const auto batched = cn.lookup(values);
+  for (std::size_t k = 0U; k < values.size(); ++k) {
+    const auto single = cn.lookup(values[k]);
+    EXPECT_EQ(batched[k].r, single.r);
+    EXPECT_EQ(batched[k].i, single.i);
+  }
+  EXPECT_TRUE(batched[5].r == &constants::zero);
+  EXPECT_EQ(RealNumber::val(batched[5].i), -1.);
+  EXPECT_EQ(batched[3].r, batched[3].i);
+}
+
+TEST_F(CNTest, BatchedDivision) {
+  const std::array<ComplexValue, 4U> values{
+      ComplexValue{0.3, -0.3}, {0., 1.}, {-0.7, 0.123}, {2., 0.}};
+  for (const auto& divisor : {ComplexValue{0.6, -0.2}, ComplexValue{0.1, 3.}}) {
+    auto divided = values;
+    divide(divided.data(), divided.size(), divisor);
+    for (std::size_t k = 0U; k < values.size(); ++k) {
+      const auto expected = values[k] / divisor;
+      EXPECT_EQ(divided[k].r, expected.r);
+      EXPECT_EQ(divided[k].i, expected.i);
+    }
+  }
+}
@@ -1,10 +1,16 @@
 #include "CircuitOptimizer.hpp"
 #include "QuantumComputation.hpp"
+#include "dd/Benchmark.hpp"
 #include "dd/FunctionalityConstruction.hpp"
 #include "dd/Simulation.hpp"
+#include "dd/statistics/PackageStatistics.hpp"
 
 #include "gtest/gtest.h"
 #include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 using namespace qc;
 
@@ -504,3 +510,420 @@ TEST_F(DDFunctionality, FuseSingleQubitGatesAcrossOtherGates) {
   EXPECT_EQ(qc.getNops(), 2);
   EXPECT_EQ(e, f);
 }
+
+TEST_F(DDFunctionality, CollectBlocks) {
+  nqubits = 3;
+  QuantumComputation qc(nqubits);
+  qc.h(0);
+  qc.cx(0, 1);
+  qc.t(1);
+  qc.cx(1, 2);
+  qc.h(2);
+  e = buildFunctionality(&qc, *dd);
+
+  // larger gates are kept and single gates are not wrapped
+  auto single = qc;
+  CircuitOptimizer::collectBlocks(single, 1U);
+  EXPECT_EQ(single.getNops(), 5);
+  EXPECT_EQ(buildFunctionality(&single, *dd), e);
+
+  auto pairs = qc;
+  CircuitOptimizer::collectBlocks(pairs, 2U);
+  pairs.print(std::cout);
+  ASSERT_EQ(pairs.getNops(), 2);
+  EXPECT_TRUE(pairs.at(0)->isCompoundOperation());
+  EXPECT_EQ(dynamic_cast<CompoundOperation*>(pairs.at(0).get())->size(), 3U);
+  EXPECT_TRUE(pairs.at(1)->isCompoundOperation());
+  EXPECT_EQ(dynamic_cast<CompoundOperation*>(pairs.at(1).get())->size(), 2U);
+  EXPECT_EQ(buildFunctionality(&pairs, *dd), e);
+
+  auto all = qc;
+  CircuitOptimizer::collectBlocks(all, 3U);
+  EXPECT_EQ(all.getNops(), 1);
+  EXPECT_EQ(buildFunctionality(&all, *dd), e);
+}
+
+TEST_F(DDFunctionality, CollectBlocksAcrossBlocks) {
+  nqubits = 4;
+  QuantumComputation qc(nqubits, 1U);
+  qc.h(0);
+  qc.h(1);
+  qc.h(2);
+  qc.cx(0, 1);
+  qc.measure(2, 0U);
+  qc.cx(1, 3);
+  qc.x(2);
+  qc.cz(2, 3);
+  qc.barrier({0, 1});
+  qc.y(0);
+
+  auto fused = qc;
+  CircuitOptimizer::collectBlocks(fused, 2U);
+  fused.print(std::cout);
+  // h(0) and h(1) are merged with the first CNOT, while the measurement and
+  // the barrier separate the gates on qubits 2 and 0, respectively
+  EXPECT_EQ(fused.getNops(), 7);
+  EXPECT_TRUE(fused.at(1)->isCompoundOperation());
+  EXPECT_EQ(fused.at(2)->getType(), qc::Measure);
+
+  const auto in = dd->makeZeroState(nqubits);
+  auto unfused = qc;
+  unfused.erase(unfused.begin() + 4);
+  fused.erase(fused.begin() + 2);
+  const auto expected = simulate(&unfused, in, *dd);
+  EXPECT_EQ(simulate(&fused, in, *dd), expected);
+}
+
+TEST_F(DDFunctionality, BenchmarkGateFusion) {
+  QuantumComputation qc(3U);
+  qc.h(0);
+  qc.cx(0, 1);
+  qc.t(1);
+  qc.cx(1, 2);
+  qc.h(2);
+
+  const auto exp = dd::benchmarkSimulate(qc);
+  const auto fusedExp = dd::benchmarkSimulate(qc, nullptr, 2U);
+  EXPECT_FALSE(exp->stats.contains("gate_fusion"));
+  const auto& stats = fusedExp->stats["gate_fusion"];
+  EXPECT_EQ(stats["block_size"], 2U);
+  EXPECT_EQ(stats["operations_before"], 5U);
+  EXPECT_EQ(stats["operations_after"], 2U);
+  EXPECT_EQ(stats["fused_blocks"], 2U);
+  EXPECT_EQ(stats["fused_gates"], 5U);
+
+  const auto expected = exp->sim.getVector();
+  const auto actual = fusedExp->sim.getVector();
+  ASSERT_EQ(actual.size(), expected.size());
+  for (std::size_t i = 0U; i < expected.size(); ++i) {
+    EXPECT_NEAR(std::abs(actual[i] - expected[i]), 0., 1e-10);
+  }
+
+  const auto func = dd::benchmarkFunctionalityConstruction(qc);
+  const auto fusedFunc =
+      dd::benchmarkFunctionalityConstruction(qc, false, nullptr, 2U);
+  EXPECT_EQ(fusedFunc->stats["gate_fusion"]["fused_gates"], 5U);
+  EXPECT_EQ(fusedFunc->func.size(), func->func.size());
+}
+
+TEST_F(DDFunctionality, SimulateParallelDynamicCircuit) {
+  QuantumComputation qc(2U, 2U);
+  qc.h(0);
+  qc.measure(0, 0U);
+  qc.classicControlled(qc::X, 1, {0, 1U}, 1U);
+  qc.measure(1, 1U);
+  qc.reset(0);
+
+  const std::size_t shots = 1000U;
+  const std::size_t seed = 12345U;
+  const auto in = dd->makeZeroState(2U);
+  const auto counts = simulateParallel(&qc, in, *dd, shots, seed, 1U);
+
+  // the results only depend on the seed
+  EXPECT_EQ(simulateParallel(&qc, in, *dd, shots, seed, 4U), counts);
+  EXPECT_EQ(simulateParallel(&qc, in, *dd, shots, seed, 7U), counts);
+
+  // errors in the workers are propagated to the caller
+  dd->setMemoryBudget(1U);
+  EXPECT_THROW(
+      static_cast<void>(simulateParallel(&qc, in, *dd, shots, seed, 4U)),
+      dd::MemoryBudgetExceeded);
+  dd->setMemoryBudget(0U);
+
+  std::size_t total = 0U;
+  for (const auto& [bits, count] : counts) {
+    EXPECT_TRUE(bits == "00" || bits == "11") << bits;
+    EXPECT_NEAR(static_cast<double>(count), 500., 100.);
+    total += count;
+  }
+  EXPECT_EQ(total, shots);
+}
+
+TEST_F(DDFunctionality, SimulateParallelStaticCircuit) {
+  QuantumComputation qc(2U, 2U);
+  qc.h(0);
+  qc.cx(0, 1);
+  qc.measureAll(false);
+
+  const std::size_t shots = 100U;
+  const auto in = dd->makeZeroState(2U);
+  const auto counts = simulateParallel(&qc, in, *dd, shots, 42U, 4U);
+  EXPECT_EQ(counts, simulate(&qc, in, *dd, shots, 42U));
+  EXPECT_EQ(counts.at("00") + counts.at("11"), shots);
+}
+
+TEST_F(DDFunctionality, SimulateBranching) {
+  QuantumComputation qc(3U, 3U);
+  qc.h(0);
+  qc.h(1);
+  qc.measure({0, 1}, {0U, 1U});
+  // flip the last qubit iff both measurements yielded one
+  qc.classicControlled(qc::X, 2, {0, 2U}, 3U);
+  qc.reset({0, 1});
+  qc.measure(2, 2U);
+
+  const auto in = dd->makeZeroState(3U);
+  EXPECT_TRUE(simulateBranching(&qc, in, *dd, 0U, 42U).empty());
+
+  const std::size_t shots = 10000U;
+  const auto counts = simulateBranching(&qc, in, *dd, shots, 42U);
+  EXPECT_EQ(simulateBranching(&qc, in, *dd, shots, 42U), counts);
+
+  std::size_t total = 0U;
+  for (const auto& [bits, count] : counts) {
+    EXPECT_TRUE(bits == "000" || bits == "001" || bits == "010" ||
+                bits == "111")
+        << bits;
+    EXPECT_NEAR(static_cast<double>(count) / static_cast<double>(shots), 0.25,
+                0.03);
+    total += count;
+  }
+  EXPECT_EQ(total, shots);
+  EXPECT_EQ(counts.size(), 4U);
+}
+
+TEST_F(DDFunctionality, GateCache) {
+  const auto& stats = dd->gateCache.getStats();
+  const StandardOperation rx(nqubits, 0, 1, RX, {PI_4});
+  const auto first = getDD(&rx, *dd);
+  EXPECT_EQ(stats.lookups, 1U);
+  EXPECT_EQ(stats.hits, 0U);
+
+  // repeated gates are served from the cache and survive regular collections
+  dd->garbageCollect();
+  const auto second = getDD(&rx, *dd);
+  EXPECT_EQ(second, first);
+  EXPECT_EQ(stats.hits, 1U);
+
+  // the inverse, other parameters, and permuted targets are distinct gates
+  const auto inverse = getInverseDD(&rx, *dd);
+  const StandardOperation rx2(nqubits, 0, 1, RX, {PI_2});
+  const auto other = getDD(&rx2, *dd);
+  Permutation perm{};
+  for (Qubit q = 0; q < nqubits; ++q) {
+    perm[q] = static_cast<Qubit>(nqubits - 1U - q);
+  }
+  const auto permuted = getDD(&rx, *dd, perm);
+  EXPECT_EQ(stats.hits, 1U);
+  EXPECT_EQ(stats.numEntries, 4U);
+  EXPECT_NE(inverse, first);
+  EXPECT_NE(other, first);
+  EXPECT_NE(permuted, first);
+  EXPECT_EQ(dd->multiply(inverse, first), dd->makeIdent(nqubits));
+
+  const auto j = dd::getStatistics(dd.get());
+  EXPECT_EQ(j["gate_cache"]["hits"], 1U);
+
+  // forced garbage collection releases all cached gates
+  dd->garbageCollect(true);
+  EXPECT_EQ(stats.numEntries, 0U);
+  EXPECT_TRUE(dd->gateCache.getTable().empty());
+}
+
+TEST_F(DDFunctionality, LocalGateDD) {
+  QuantumComputation qc(nqubits);
+  qc.h(1);
+  qc.cx(0, 2);
+  qc.mcrz(PI_4, {0, 1}, 2);
+  qc.rzz(PI_2, 1, 2);
+  qc.cswap(3, 0, 1);
+  qc.swap(0, 2);
+
+  Permutation perm{};
+  for (Qubit q = 0; q < nqubits; ++q) {
+    perm[q] = static_cast<Qubit>(nqubits - 1U - q);
+  }
+  auto f = dd->makeGateDD(dd::H_MAT, nqubits, 3U);
+  dd->incRef(f);
+  const auto vec = dd->makeBasisState(nqubits, {true, false, true, true});
+  for (const auto& op : qc) {
+    // the local DD spans the qubits up to the highest one the gate acts on
+    const auto* standardOp = dynamic_cast<const StandardOperation*>(op.get());
+    const auto local = dd::getLocalDD(standardOp, *dd, Permutation{});
+    EXPECT_EQ(local.p->v, *op->getUsedQubits().rbegin()) << op->getName();
+
+    for (const auto& initial : {Permutation{}, perm}) {
+      auto applied = initial;
+      auto multiplied = initial;
+      EXPECT_EQ(dd::applyUnitaryOperation(op.get(), f, *dd, applied),
+                dd->multiply(dd::getDD(op.get(), *dd, multiplied), f))
+          << op->getName();
+      EXPECT_EQ(applied, multiplied);
+
+      applied = multiplied = initial;
+      EXPECT_EQ(dd::applyUnitaryOperation(op.get(), vec, *dd, applied),
+                dd->multiply(dd::getDD(op.get(), *dd, multiplied), vec))
+          << op->getName();
+    }
+  }
+  dd->decRef(f);
+}
+
+TEST_F(DDFunctionality, SimulateApproximately) {
+  const std::size_t n = 10U;
+  QuantumComputation qc(n);
+  std::mt19937_64 rng(42U); // NOLINT(cert-msc51-cpp)
+  for (std::size_t layer = 0U; layer < 4U; ++layer) {
+    for (std::size_t q = 0U; q < n; ++q) {
+      qc.ry(dist(rng), static_cast<Qubit>(q));
+      qc.rz(dist(rng), static_cast<Qubit>(q));
+    }
+    for (std::size_t q = 0U; q + 1U < n; ++q) {
+      qc.cx(static_cast<Qubit>(q), static_cast<Qubit>(q + 1U));
+    }
+  }
+
+  auto pkg = std::make_unique<dd::Package<>>(n);
+  const auto exact = simulate(&qc, pkg->makeZeroState(n), *pkg);
+
+  // no approximation is performed by default
+  const auto unbounded = simulate(&qc, pkg->makeZeroState(n), *pkg,
+                                  dd::ApproximationParameters{});
+  EXPECT_EQ(unbounded.state, exact);
+  EXPECT_EQ(unbounded.fidelity, 1.);
+  EXPECT_EQ(unbounded.numApproximations, 0U);
+
+  const dd::ApproximationParameters params{64U, 0.99, 0.9};
+  const auto approx = simulate(&qc, pkg->makeZeroState(n), *pkg, params);
+  EXPECT_GT(approx.numApproximations, 0U);
+  EXPECT_GE(approx.fidelity, params.finalFidelity);
+  EXPECT_LT(approx.fidelity, 1.);
+  EXPECT_NEAR(pkg->fidelity(exact, approx.state), approx.fidelity, 0.05);
+}
+
+TEST_F(DDFunctionality, BuildFunctionalityParallel) {
+  QuantumComputation qc(nqubits);
+  for (std::size_t i = 0U; i < 5U; ++i) {
+    qc.h(0);
+    qc.cx(0, 1);
+    // SWAPs only change the permutation, which every range has to know
+    qc.swap(1, 2);
+    qc.rz(0.3, 2);
+    qc.cx(2, 3);
+    qc.swap(0, 3);
+    qc.t(1);
+  }
+
+  const auto expected = dd::buildFunctionality(&qc, *dd);
+  for (const std::size_t numThreads : {1U, 2U, 3U, 8U, 64U}) {
+    const auto f = dd::buildFunctionalityParallel(&qc, *dd, numThreads);
+    EXPECT_EQ(f, expected) << "Threads: " << numThreads;
+    dd->decRef(f);
+  }
+  e = expected;
+
+  // the worker packages take over the settings of the package
+  dd->enableParallelEvaluation(2U);
+  const auto f = dd::buildFunctionalityParallel(&qc, *dd, 2U);
+  EXPECT_EQ(f, expected);
+  dd->decRef(f);
+  dd->disableParallelEvaluation();
+  dd->setMemoryBudget(1U);
+  EXPECT_THROW(static_cast<void>(dd::buildFunctionalityParallel(&qc, *dd, 2U)),
+               dd::MemoryBudgetExceeded);
+  dd->setMemoryBudget(0U);
+}
+
+TEST_F(DDFunctionality, OperationTrace) {
+  QuantumComputation qc(nqubits);
+  qc.h(0);
+  for (Qubit q = 1U; q < nqubits; ++q) {
+    qc.cx(q - 1U, q);
+  }
+
+  std::stringstream json{};
+  dd::JSONTraceWriter jsonWriter(json);
+  const auto in = dd->makeZeroState(nqubits);
+  const auto state = dd::simulate(&qc, in, *dd, &jsonWriter);
+  std::string line{};
+  std::size_t events = 0U;
+  std::size_t nodes = in.size();
+  while (std::getline(json, line)) {
+    const auto event = nlohmann::json::parse(line);
+    EXPECT_EQ(event["index"], events);
+    EXPECT_EQ(event["nodes_before"], nodes);
+    nodes = event["nodes_after"];
+    EXPECT_GE(event["runtime"], 0.);
+    EXPECT_GE(event["compute_table_lookups"], event["compute_table_hits"]);
+    ++events;
+  }
+  EXPECT_EQ(events, qc.size());
+  EXPECT_EQ(nodes, state.size());
+  dd->decRef(state);
+
+  std::stringstream csv{};
+  dd::CSVTraceWriter csvWriter(csv);
+  e = dd::buildFunctionality(&qc, *dd, &csvWriter);
+  std::getline(csv, line);
+  EXPECT_EQ(line.rfind("index,operation,runtime,", 0U), 0U);
+  events = 0U;
+  while (std::getline(csv, line)) {
+    EXPECT_EQ(line.rfind(std::to_string(events) + ",", 0U), 0U);
+    ++events;
+  }
+  EXPECT_EQ(events, qc.size());
+}
+
+TEST_F(DDFunctionality, OperationTraceDynamicCircuit) {
+  QuantumComputation qc(2U, 2U);
+  qc.h(0);
+  qc.measure(0, 0U);
+  qc.classicControlled(qc::X, 1, {0, 1U}, 1U);
+  qc.measure(1, 1U);
+
+  const std::size_t shots = 16U;
+  const auto in = dd->makeZeroState(2U);
+  std::stringstream json{};
+  dd::JSONTraceWriter writer(json);
+  const auto counts = simulate(&qc, in, *dd, shots, 42U, &writer);
+
+  // every shot is traced separately and skips the classic-controlled X iff
+  // the first measurement yielded zero
+  std::string line{};
+  std::size_t events = 0U;
+  std::size_t controlledEvents = 0U;
+  while (std::getline(json, line)) {
+    const auto event = nlohmann::json::parse(line);
+    EXPECT_LT(event["index"], qc.size());
+    EXPECT_TRUE(event.contains("collected_vector_nodes"));
+    EXPECT_TRUE(event.contains("collected_real_numbers"));
+    if (event["index"] == 2U) {
+      ++controlledEvents;
+    }
+    ++events;
+  }
+  const auto ones = counts.count("11") == 0U ? 0U : counts.at("11");
+  EXPECT_EQ(controlledEvents, ones);
+  EXPECT_EQ(events, (qc.size() - 1U) * shots + ones);
+
+  // the figures of the worker packages cannot be traced
+  EXPECT_THROW(simulateParallel(&qc, in, *dd, shots, 42U, 2U, &writer),
+               std::invalid_argument);
+  EXPECT_THROW(dd::benchmarkFunctionalityConstruction(qc, true, &writer),
+               std::invalid_argument);
+}
+
+TEST_F(DDFunctionality, OperationTraceBranching) {
+  QuantumComputation qc(2U, 2U);
+  qc.h(0);
+  qc.measure(0, 0U);
+  qc.classicControlled(qc::X, 1, {0, 1U}, 1U);
+  qc.measure(1, 1U);
+
+  const auto in = dd->makeZeroState(2U);
+  std::stringstream json{};
+  dd::JSONTraceWriter writer(json);
+  const auto counts = simulateBranching(&qc, in, *dd, 1000U, 42U, &writer);
+  ASSERT_EQ(counts.size(), 2U);
+
+  // the H gate is applied once and the X gate only in the branch of outcome
+  // one, while measurements are not traced
+  std::string line{};
+  std::vector<std::string> operations{};
+  while (std::getline(json, line)) {
+    const auto event = nlohmann::json::parse(line);
+    operations.emplace_back(event["operation"]);
+    EXPECT_EQ(event["index"], operations.size() == 1U ? 0U : 2U);
+  }
+  EXPECT_EQ(operations.size(), 2U);
+}
@@ -12,6 +12,7 @@
 #include <random>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
 #include <vector>
 
 using namespace qc::literals;
@@ -280,6 +281,81 @@ TEST(DDPackageTest, PartialIdentityTrace) {
   EXPECT_EQ(dd::RealNumber::val(mul.w.r), 4.0);
 }
 
+TEST(DDPackageTest, PartialTraceComputeTable) {
+  const auto nqubits = 3U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  auto m = dd->makeGateDD(dd::H_MAT, nqubits, 0U);
+  m = dd->multiply(dd->makeGateDD(dd::X_MAT, nqubits, qc::Control{0U}, 2U), m);
+  m = dd->multiply(dd->makeGateDD(dd::rzMat(0.3), nqubits, 1U), m);
+  m = dd->multiply(dd->makeGateDD(dd::H_MAT, nqubits, 2U), m);
+  dd->incRef(m);
+  const auto matrix = m.getMatrix();
+
+  // eliminating qubits 0 and 2 leaves the reduced matrix of qubit 1
+  const std::vector<bool> eliminate{true, false, true};
+  const auto reduced = dd->partialTrace(m, eliminate).getMatrix();
+  ASSERT_EQ(reduced.size(), 2U);
+  for (std::size_t i = 0U; i < 2U; ++i) {
+    for (std::size_t j = 0U; j < 2U; ++j) {
+      std::complex<dd::fp> expected{};
+      for (std::size_t q2 = 0U; q2 < 2U; ++q2) {
+        for (std::size_t q0 = 0U; q0 < 2U; ++q0) {
+          expected += matrix[(q2 << 2U) | (i << 1U) | q0]
+                            [(q2 << 2U) | (j << 1U) | q0];
+        }
+      }
+      EXPECT_NEAR(std::abs(reduced[i][j] - expected), 0., 1e-10);
+    }
+  }
+
+  // repeating the trace is answered by the compute table
+  const auto& stats = dd->matrixTrace.getStats();
+  const auto hits = stats.hits;
+  EXPECT_EQ(dd->partialTrace(m, eliminate).getMatrix(), reduced);
+  EXPECT_GT(stats.hits, hits);
+
+  // a different elimination pattern does not reuse the results
+  std::complex<dd::fp> expectedTrace{};
+  for (std::size_t i = 0U; i < matrix.size(); ++i) {
+    expectedTrace += matrix[i][i];
+  }
+  const auto fullTrace = dd->trace(m);
+  EXPECT_NEAR(fullTrace.r, expectedTrace.real(), 1e-10);
+  EXPECT_NEAR(fullTrace.i, expectedTrace.imag(), 1e-10);
+  EXPECT_EQ(dd->partialTrace(m, eliminate).getMatrix(), reduced);
+
+  const auto statistics = dd::getStatistics(dd.get());
+  EXPECT_TRUE(statistics["compute_tables"].contains("matrix_trace"));
+  dd->decRef(m);
+}
+
+TEST(DDPackageTest, IdentityCheckComputeTable) {
+  const auto nqubits = 4U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  // a product that is the identity up to rounding, but not structurally
+  auto m = dd->makeGateDD(dd::rzMat(0.3), nqubits, 1U);
+  m = dd->multiply(dd->makeGateDD(dd::rzMat(-0.3 + 1e-8), nqubits, 1U), m);
+  m = dd->multiply(dd->makeGateDD(dd::X_MAT, nqubits, qc::Control{3U}, 0U), m);
+  m = dd->multiply(dd->makeGateDD(dd::X_MAT, nqubits, qc::Control{3U}, 0U), m);
+  dd->incRef(m);
+
+  const auto& stats = dd->matrixIdentity.getStats();
+  EXPECT_TRUE(dd->isCloseToIdentity(m, 1e-6));
+  const auto hits = stats.hits;
+  EXPECT_TRUE(dd->isCloseToIdentity(m, 1e-6));
+  EXPECT_GT(stats.hits, hits);
+
+  // other parameters do not reuse the results
+  EXPECT_FALSE(dd->isCloseToIdentity(m, 1e-10));
+  EXPECT_TRUE(dd->isCloseToIdentity(m, 1e-6));
+
+  // the entries are invalidated once the nodes are collected
+  dd->decRef(m);
+  dd->garbageCollect(true);
+  EXPECT_EQ(dd->matrixIdentity.getStats().numEntries, 0U);
+  EXPECT_TRUE(dd->isCloseToIdentity(dd->makeIdent(nqubits)));
+}
+
 TEST(DDPackageTest, StateGenerationManipulation) {
   const std::size_t nqubits = 6;
   auto dd = std::make_unique<dd::Package<>>(nqubits);
@@ -2268,3 +2344,983 @@ TEST(DDPackageTest, ReduceAncillaRegression) {
 
   EXPECT_EQ(outputMatrix, expected);
 }
+
+TEST(DDPackageTest, ConcurrentNodeConstruction) {
+  const auto nqubits = 4U;
+  constexpr auto numThreads = 4U;
+  constexpr std::size_t numBasisStates = 6U;
+  std::size_t numStates = 1U;
+  for (auto q = 0U; q < nqubits; ++q) {
+    numStates *= numBasisStates;
+  }
+
+  const auto makeState = [&](dd::Package<>& pkg, std::size_t idx) {
+    std::vector<dd::BasisStates> state(nqubits);
+    for (auto& s : state) {
+      s = static_cast<dd::BasisStates>(idx % numBasisStates);
+      idx /= numBasisStates;
+    }
+    return pkg.makeBasisState(nqubits, state);
+  };
+
+  // construct all states serially as a reference
+  auto reference = std::make_unique<dd::Package<>>(nqubits);
+  for (std::size_t i = 0U; i < numStates; ++i) {
+    makeState(*reference, i);
+  }
+
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  dd->setConcurrent(true);
+  EXPECT_TRUE(dd->isConcurrent());
+
+  std::vector<std::vector<dd::vEdge>> states(numThreads,
+                                             std::vector<dd::vEdge>(numStates));
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads);
+  for (auto t = 0U; t < numThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      // every thread starts at a different offset to provoke contention
+      for (std::size_t i = 0U; i < numStates; ++i) {
+        const auto idx = (i + (t * numStates / numThreads)) % numStates;
+        states[t][idx] = makeState(*dd, idx);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  dd->setConcurrent(false);
+  EXPECT_FALSE(dd->isConcurrent());
+
+  // all threads must have obtained the very same canonical nodes and weights
+  for (auto t = 1U; t < numThreads; ++t) {
+    for (std::size_t i = 0U; i < numStates; ++i) {
+      EXPECT_EQ(states[t][i], states[0][i]);
+    }
+  }
+  EXPECT_EQ(dd->vUniqueTable.getNumEntries(),
+            reference->vUniqueTable.getNumEntries());
+  EXPECT_EQ(dd->cn.realCount(), reference->cn.realCount());
+  EXPECT_EQ(dd->vMemoryManager.getStats().numUsed,
+            reference->vMemoryManager.getStats().numUsed);
+
+  for (std::size_t i = 0U; i < numStates; ++i) {
+    EXPECT_EQ(states[0][i].getVector(), makeState(*reference, i).getVector());
+  }
+}
+
+TEST(DDPackageTest, ParallelAdditionAndMultiplication) {
+  const auto nqubits = 5U;
+  const auto dim = 1ULL << nqubits;
+  std::mt19937_64 mt(42U); // NOLINT(cert-msc51-cpp)
+  std::uniform_real_distribution<dd::fp> dist(-1., 1.);
+  dd::CMat matA(dim, dd::CVec(dim));
+  dd::CMat matB(dim, dd::CVec(dim));
+  dd::CVec vec(dim);
+  for (std::size_t i = 0U; i < dim; ++i) {
+    for (std::size_t j = 0U; j < dim; ++j) {
+      matA[i][j] = {dist(mt), dist(mt)};
+      matB[i][j] = {dist(mt), dist(mt)};
+    }
+    vec[i] = {dist(mt), dist(mt)};
+  }
+
+  const auto compute = [&](dd::Package<>& pkg) {
+    const auto a = pkg.makeDDFromMatrix(matA);
+    const auto b = pkg.makeDDFromMatrix(matB);
+    const auto v = pkg.makeStateFromVector(vec);
+    return std::tuple{pkg.multiply(a, v).getVector(),
+                      pkg.multiply(a, b).getMatrix(),
+                      pkg.add(a, b).getMatrix(), pkg.add(v, v).getVector()};
+  };
+
+  auto serial = std::make_unique<dd::Package<>>(nqubits);
+  const auto [serialMV, serialMM, serialAddM, serialAddV] = compute(*serial);
+
+  auto parallel = std::make_unique<dd::Package<>>(nqubits);
+  parallel->enableParallelEvaluation(4U, 2U);
+  EXPECT_TRUE(parallel->isParallelEvaluationEnabled());
+  EXPECT_TRUE(parallel->isConcurrent());
+  const auto [parallelMV, parallelMM, parallelAddM, parallelAddV] =
+      compute(*parallel);
+  parallel->disableParallelEvaluation();
+  EXPECT_FALSE(parallel->isParallelEvaluationEnabled());
+  EXPECT_FALSE(parallel->isConcurrent());
+
+  constexpr auto tol = 1e-8;
+  for (std::size_t i = 0U; i < dim; ++i) {
+    EXPECT_NEAR(std::abs(parallelMV[i] - serialMV[i]), 0., tol);
+    EXPECT_NEAR(std::abs(parallelAddV[i] - serialAddV[i]), 0., tol);
+    for (std::size_t j = 0U; j < dim; ++j) {
+      EXPECT_NEAR(std::abs(parallelMM[i][j] - serialMM[i][j]), 0., tol);
+      EXPECT_NEAR(std::abs(parallelAddM[i][j] - serialAddM[i][j]), 0., tol);
+    }
+  }
+}
+
+TEST(DDPackageTest, SetAssociativeComputeTable) {
+  std::array<dd::vNode, 3> nodes{};
+  const auto result = dd::vCachedEdge::one();
+
+  // a direct-mapped table with a single bucket can only hold a single entry
+  dd::ComputeTable<dd::vNode*, dd::vNode*, dd::vCachedEdge, 1U> direct{};
+  direct.insert(&nodes[0], &nodes[0], result);
+  direct.insert(&nodes[1], &nodes[1], result);
+  EXPECT_EQ(direct.lookup(&nodes[0], &nodes[0]), nullptr);
+  EXPECT_NE(direct.lookup(&nodes[1], &nodes[1]), nullptr);
+  EXPECT_EQ(direct.getStats().evictions, 1U);
+
+  // a two-way table with a single bucket holds the two most recent entries
+  dd::ComputeTable<dd::vNode*, dd::vNode*, dd::vCachedEdge, 1U, 2U> table{};
+  table.insert(&nodes[0], &nodes[0], result);
+  table.insert(&nodes[1], &nodes[1], result);
+  EXPECT_NE(table.lookup(&nodes[0], &nodes[0]), nullptr);
+  EXPECT_NE(table.lookup(&nodes[1], &nodes[1]), nullptr);
+
+  // the entry for nodes[0] is now the least recently used one
+  table.insert(&nodes[2], &nodes[2], result);
+  EXPECT_EQ(table.lookup(&nodes[0], &nodes[0]), nullptr);
+  EXPECT_NE(table.lookup(&nodes[1], &nodes[1]), nullptr);
+  EXPECT_NE(table.lookup(&nodes[2], &nodes[2]), nullptr);
+
+  const auto& stats = table.getStats();
+  EXPECT_EQ(stats.numWays, 2U);
+  EXPECT_EQ(stats.numBuckets, 2U);
+  EXPECT_EQ(stats.lookups, 5U);
+  EXPECT_EQ(stats.hits, 4U);
+  EXPECT_EQ(stats.evictions, 1U);
+  EXPECT_EQ(stats.numEntries, 2U);
+  ASSERT_EQ(stats.hitsPerWay.size(), 2U);
+  EXPECT_EQ(stats.hitsPerWay[0], 0U);
+  EXPECT_EQ(stats.hitsPerWay[1], 4U);
+
+  const auto json = stats.json();
+  EXPECT_EQ(json["num_ways"], 2U);
+  EXPECT_EQ(json["evictions"], 1U);
+  EXPECT_EQ(json["hits_per_way"]["1"], 4U);
+}
+
+struct SetAssociativeDDPackageConfig : public dd::DDPackageConfig {
+  static constexpr std::size_t CT_NWAYS = 4U;
+};
+
+TEST(DDPackageTest, SetAssociativePackageConfig) {
+  const auto nqubits = 3U;
+  auto dd = std::make_unique<dd::Package<SetAssociativeDDPackageConfig>>(
+      nqubits);
+  auto reference = std::make_unique<dd::Package<>>(nqubits);
+
+  auto state = dd->makeZeroState(nqubits);
+  auto refState = reference->makeZeroState(nqubits);
+  for (auto q = 0U; q < nqubits; ++q) {
+    state = dd->multiply(dd->makeGateDD(dd::H_MAT, nqubits, q), state);
+    refState = reference->multiply(reference->makeGateDD(dd::H_MAT, nqubits, q),
+                                   refState);
+  }
+  EXPECT_EQ(state.getVector(), refState.getVector());
+
+  const auto stats = dd::getStatistics(dd.get());
+  EXPECT_EQ(stats["compute_tables"]["matrix_vector_mult"]["num_ways"], 4U);
+}
+
+struct SmallUniqueTableDDPackageConfig : public dd::DDPackageConfig {
+  static constexpr std::size_t UT_VEC_NBUCKET = 4U;
+};
+
+TEST(DDPackageTest, UniqueTableGrowsIncrementally) {
+  const auto nqubits = 6U;
+  auto dd =
+      std::make_unique<dd::Package<SmallUniqueTableDDPackageConfig>>(nqubits);
+  auto& table = dd->vUniqueTable;
+  const auto topQubit = nqubits - 1U;
+  EXPECT_EQ(table.getNumBuckets(topQubit), 4U);
+
+  const auto numStates = 1ULL << nqubits;
+  const auto makeState = [&](const std::size_t idx) {
+    std::vector<bool> bits(nqubits);
+    for (auto q = 0U; q < nqubits; ++q) {
+      bits[q] = ((idx >> q) & 1U) != 0U;
+    }
+    return dd->makeBasisState(nqubits, bits);
+  };
+
+  std::vector<dd::vEdge> states{};
+  for (std::size_t i = 0U; i < numStates; ++i) {
+    states.emplace_back(makeState(i));
+  }
+  // the top-level table holds one node per state and must have grown
+  EXPECT_EQ(table.getStats(topQubit).numEntries, numStates);
+  EXPECT_GT(table.getNumBuckets(topQubit), 4U);
+  EXPECT_LE(static_cast<double>(table.getStats(topQubit).numEntries),
+            table.getMaxLoadFactor() *
+                static_cast<double>(table.getNumBuckets(topQubit)));
+
+  // all nodes must still be found, regardless of whether they were migrated
+  for (std::size_t i = 0U; i < numStates; ++i) {
+    EXPECT_EQ(makeState(i), states[i]);
+  }
+  EXPECT_EQ(table.getStats(topQubit).numEntries, numStates);
+  EXPECT_FALSE(table.isRehashing(topQubit));
+
+  // garbage collection and clearing work across grown tables
+  dd->garbageCollect(true);
+  EXPECT_EQ(table.getNumEntries(), 0U);
+  EXPECT_EQ(dd->vMemoryManager.getStats().numUsed, 0U);
+  dd->reset();
+  EXPECT_EQ(table.getNumBuckets(topQubit), 4U);
+
+  EXPECT_THROW(table.setMaxLoadFactor(0.), std::invalid_argument);
+}
+
+TEST(DDPackageTest, ComputeTableResize) {
+  std::array<dd::mNode, 64> left{};
+  std::array<dd::vNode, 64> right{};
+  const auto result = dd::vCachedEdge::one();
+  dd::ComputeTable<dd::mNode*, dd::vNode*, dd::vCachedEdge, 2U> table{};
+  EXPECT_EQ(table.getNumBuckets(), 2U);
+  EXPECT_THROW(table.resize(3U), std::invalid_argument);
+
+  // the empty table is not saturated
+  EXPECT_FALSE(table.growIfNeeded(1024U));
+  for (std::size_t i = 0U; i < left.size(); ++i) {
+    table.insert(&left[i], &right[i], result);
+  }
+  // the table is saturated, but growing is limited
+  ASSERT_GE(table.getStats().loadFactor(), 0.75);
+  EXPECT_FALSE(table.growIfNeeded(2U));
+  EXPECT_TRUE(table.growIfNeeded(1024U));
+  EXPECT_EQ(table.getNumBuckets(), 4U);
+  EXPECT_EQ(table.getStats().numBuckets, 4U);
+
+  table.resize(128U);
+  for (std::size_t i = 0U; i < left.size(); ++i) {
+    table.insert(&left[i], &right[i], result);
+  }
+  std::vector<bool> present(left.size());
+  for (std::size_t i = 0U; i < left.size(); ++i) {
+    present[i] = table.lookup(&left[i], &right[i]) != nullptr;
+  }
+  const auto numEntries = table.getStats().numEntries;
+
+  // growing the table keeps all entries
+  table.resize(256U);
+  EXPECT_EQ(table.getStats().numEntries, numEntries);
+  for (std::size_t i = 0U; i < left.size(); ++i) {
+    EXPECT_EQ(table.lookup(&left[i], &right[i]) != nullptr, present[i]);
+  }
+}
+
+TEST(DDPackageTest, ComputeTableAutomaticGrowth) {
+  const auto nqubits = 3U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  EXPECT_EQ(dd->getComputeTableSizeLimit(), 0U);
+  dd->resizeComputeTables(2U);
+  EXPECT_EQ(dd->matrixVectorMultiplication.getNumBuckets(), 2U);
+
+  dd->setComputeTableSizeLimit(64U);
+  auto state = dd->makeZeroState(nqubits);
+  // the products occupy enough buckets to trigger the growth regardless of
+  // where their (address-based) hashes fall
+  for (const auto& mat : {dd::H_MAT, dd::Z_MAT, dd::Z_MAT}) {
+    for (auto q = 0U; q < nqubits; ++q) {
+      state = dd->multiply(dd->makeGateDD(mat, nqubits, q), state);
+      dd->garbageCollect();
+    }
+  }
+  EXPECT_GT(dd->matrixVectorMultiplication.getNumBuckets(), 2U);
+  EXPECT_LE(dd->matrixVectorMultiplication.getNumBuckets(), 64U);
+  const auto amplitude = 1. / std::sqrt(1U << nqubits);
+  for (const auto& amp : state.getVector()) {
+    EXPECT_NEAR(amp.real(), amplitude, 1e-10);
+  }
+}
+
+struct OpenAddressingDDPackageConfig : public dd::DDPackageConfig {
+  static constexpr std::size_t UT_VEC_NBUCKET = 8U;
+  static constexpr bool UT_OPEN_ADDRESSING = true;
+};
+
+TEST(DDPackageTest, OpenAddressingUniqueTable) {
+  const auto nqubits = 6U;
+  auto dd =
+      std::make_unique<dd::Package<OpenAddressingDDPackageConfig>>(nqubits);
+  auto& table = dd->vUniqueTable;
+  static_assert(
+      std::is_same_v<std::remove_reference_t<decltype(table)>,
+                     dd::OpenAddressingUniqueTable<dd::vNode, 8U>>);
+  const auto topQubit = nqubits - 1U;
+  EXPECT_EQ(table.getNumBuckets(topQubit), 8U);
+
+  const auto numStates = 1ULL << nqubits;
+  const auto makeState = [&](const std::size_t idx) {
+    std::vector<bool> bits(nqubits);
+    for (auto q = 0U; q < nqubits; ++q) {
+      bits[q] = ((idx >> q) & 1U) != 0U;
+    }
+    return dd->makeBasisState(nqubits, bits);
+  };
+
+  std::vector<dd::vEdge> states{};
+  for (std::size_t i = 0U; i < numStates; ++i) {
+    states.emplace_back(makeState(i));
+  }
+  EXPECT_EQ(table.getStats(topQubit).numEntries, numStates);
+  EXPECT_GT(table.getNumBuckets(topQubit), numStates);
+
+  // all nodes are found again after the table has grown
+  for (std::size_t i = 0U; i < numStates; ++i) {
+    EXPECT_EQ(makeState(i), states[i]);
+  }
+  EXPECT_EQ(table.getStats(topQubit).numEntries, numStates);
+
+  // dead nodes are removed while live ones remain reachable
+  for (std::size_t i = 0U; i < numStates; i += 2U) {
+    dd->incRef(states[i]);
+  }
+  dd->garbageCollect(true);
+  EXPECT_EQ(table.getStats(topQubit).numEntries, numStates / 2U);
+  for (std::size_t i = 0U; i < numStates; i += 2U) {
+    EXPECT_EQ(makeState(i), states[i]);
+    dd->decRef(states[i]);
+  }
+  EXPECT_EQ(table.getStats(topQubit).numEntries, numStates / 2U);
+  dd->garbageCollect(true);
+  EXPECT_EQ(table.getNumEntries(), 0U);
+  EXPECT_EQ(dd->vMemoryManager.getStats().numUsed, 0U);
+
+  dd->reset();
+  EXPECT_EQ(table.getNumBuckets(topQubit), 8U);
+  EXPECT_THROW(table.setMaxLoadFactor(1.), std::invalid_argument);
+}
+
+TEST(DDPackageTest, OpenAddressingMatchesChainedUniqueTable) {
+  const auto nqubits = 4U;
+  auto dd =
+      std::make_unique<dd::Package<OpenAddressingDDPackageConfig>>(nqubits);
+  auto reference = std::make_unique<dd::Package<>>(nqubits);
+
+  auto func = dd->makeIdent(nqubits);
+  auto refFunc = reference->makeIdent(nqubits);
+  for (auto q = 0U; q < nqubits; ++q) {
+    func = dd->multiply(dd->makeGateDD(dd::H_MAT, nqubits, q), func);
+    refFunc = reference->multiply(
+        reference->makeGateDD(dd::H_MAT, nqubits, q), refFunc);
+    for (auto t = q + 1U; t < nqubits; ++t) {
+      const auto phase = dd::PI / static_cast<dd::fp>(1U << (t - q));
+      func = dd->multiply(
+          dd->makeGateDD(dd::pMat(phase), nqubits, qc::Control{t}, q), func);
+      refFunc = reference->multiply(
+          reference->makeGateDD(dd::pMat(phase), nqubits, qc::Control{t}, q),
+          refFunc);
+    }
+  }
+  EXPECT_EQ(func.size(), refFunc.size());
+  EXPECT_EQ(func.getMatrix(), refFunc.getMatrix());
+  EXPECT_EQ(dd->mUniqueTable.getNumEntries(),
+            reference->mUniqueTable.getNumEntries());
+}
+
+TEST(DDPackageTest, SampleAll) {
+  const auto nqubits = 3U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+
+  // ry(pi/3) on q0 yields P(q0 = 1) = 1/4, H on q1 and X on q2
+  auto state = dd->makeZeroState(nqubits);
+  state = dd->multiply(dd->makeGateDD(dd::ryMat(dd::PI / 3.), nqubits, 0U),
+                       state);
+  state = dd->multiply(dd->makeGateDD(dd::H_MAT, nqubits, 1U), state);
+  state = dd->multiply(dd->makeGateDD(dd::X_MAT, nqubits, 2U), state);
+  dd->incRef(state);
+
+  std::mt19937_64 mt(42U);
+  EXPECT_TRUE(dd->sampleAll(state, 0U, mt).empty());
+
+  const std::size_t shots = 100000U;
+  const auto counts = dd->sampleAll(state, shots, mt);
+  const std::map<std::string, double> expected = {
+      {"100", 0.375}, {"101", 0.125}, {"110", 0.375}, {"111", 0.125}};
+  std::size_t total = 0U;
+  for (const auto& [outcome, count] : counts) {
+    ASSERT_EQ(expected.count(outcome), 1U) << outcome;
+    EXPECT_NEAR(static_cast<double>(count) / static_cast<double>(shots),
+                expected.at(outcome), 0.01);
+    total += count;
+  }
+  EXPECT_EQ(total, shots);
+
+  // sampling does not alter the state
+  const auto vec = state.getVector();
+  EXPECT_NEAR(std::norm(vec[4]), 0.375, 1e-10);
+
+  // terminal states yield the empty outcome
+  const auto terminalCounts = dd->sampleAll(dd::vEdge::one(), 10U, mt);
+  EXPECT_EQ(terminalCounts.at(""), 10U);
+
+  // the same consistency checks as for measureAll apply
+  auto zeroState = state;
+  zeroState.w = dd::Complex::zero();
+  EXPECT_THROW(dd->sampleAll(zeroState, 1U, mt), std::runtime_error);
+}
+
+TEST(DDPackageTest, ApplyGateMatchesMultiplication) {
+  const auto nqubits = 4U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+
+  std::mt19937_64 mt(42U);
+  std::normal_distribution<dd::fp> dist{};
+  dd::CVec amplitudes(1U << nqubits);
+  dd::fp norm = 0.;
+  for (auto& amplitude : amplitudes) {
+    amplitude = {dist(mt), dist(mt)};
+    norm += std::norm(amplitude);
+  }
+  for (auto& amplitude : amplitudes) {
+    amplitude /= std::sqrt(norm);
+  }
+  auto state = dd->makeStateFromVector(amplitudes);
+  dd->incRef(state);
+
+  const auto mat = dd::uMat(0.1, 0.2, 0.3);
+  const std::vector<qc::Controls> controls = {
+      {}, {3_pc}, {0_nc}, {0_pc, 3_nc}, {0_nc, 2_pc, 3_pc}};
+  for (const auto& c : controls) {
+    for (qc::Qubit target = 0U; target < nqubits; ++target) {
+      if (c.count(target) != 0U) {
+        continue;
+      }
+      const auto expected =
+          dd->multiply(dd->makeGateDD(mat, nqubits, c, target), state);
+      const auto actual = dd->applyGate(state, mat, target, c);
+      const auto expectedVector = expected.getVector();
+      const auto actualVector = actual.getVector();
+      for (std::size_t i = 0U; i < expectedVector.size(); ++i) {
+        EXPECT_NEAR(std::abs(expectedVector[i] - actualVector[i]), 0., 1e-10)
+            << "target " << target << ", amplitude " << i;
+      }
+    }
+  }
+
+  // states without amplitudes are not affected
+  EXPECT_EQ(dd->applyGate(dd::vEdge::zero(), mat, 0U), dd::vEdge::zero());
+
+  // the target and controls have to be part of the state
+  EXPECT_THROW(dd->applyGate(state, mat, nqubits), std::invalid_argument);
+  EXPECT_THROW(dd->applyGate(state, mat, 0U, {0_pc}), std::invalid_argument);
+  EXPECT_THROW(dd->applyGate(state, mat, 0U, {qc::Control{nqubits}}),
+               std::invalid_argument);
+}
+
+TEST(DDPackageTest, Snapshot) {
+  const auto nqubits = 3U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+
+  auto state = dd->makeBasisState(nqubits, {dd::BasisStates::plus,
+                                            dd::BasisStates::right,
+                                            dd::BasisStates::one});
+  dd->incRef(state);
+  auto matrix = dd->multiply(
+      dd->makeGateDD(dd::uMat(0.1, 0.2, 0.3), nqubits, 0_pc, 2U),
+      dd->makeGateDD(dd::H_MAT, nqubits, 1U));
+  dd->incRef(matrix);
+
+  std::stringstream ss{};
+  dd::writeSnapshot(state, ss);
+  const auto data = ss.str();
+  const auto* bytes = reinterpret_cast<const std::byte*>(data.data());
+  const dd::Snapshot snapshot(bytes, data.size());
+  EXPECT_EQ(snapshot.kind(), dd::SnapshotKind::Vector);
+  EXPECT_EQ(snapshot.numNodes(), state.size() - 1U);
+  // the columns start with the variables of the nodes in topological order
+  for (std::size_t i = 0U; i < snapshot.numNodes(); ++i) {
+    EXPECT_EQ(snapshot.variable(i), i);
+  }
+  EXPECT_EQ(dd->importSnapshot<dd::vNode>(snapshot), state);
+  EXPECT_THROW(dd->importSnapshot<dd::mNode>(snapshot), std::runtime_error);
+
+  // snapshots can be loaded into a fresh package
+  dd::writeSnapshot(matrix, "matrix.ddsnap");
+  auto other = std::make_unique<dd::Package<>>(nqubits);
+  const auto loaded = other->loadSnapshot<dd::mNode>("matrix.ddsnap");
+  EXPECT_EQ(loaded.getMatrix(), matrix.getMatrix());
+  EXPECT_EQ(loaded.size(), matrix.size());
+  std::filesystem::remove("matrix.ddsnap");
+
+  // terminal DDs
+  std::stringstream terminal{};
+  dd::writeSnapshot(dd::vEdge::one(), terminal);
+  const auto terminalData = terminal.str();
+  EXPECT_EQ(dd->importSnapshot<dd::vNode>(dd::Snapshot(
+                reinterpret_cast<const std::byte*>(terminalData.data()),
+                terminalData.size())),
+            dd::vEdge::one());
+
+  // invalid snapshots
+  EXPECT_THROW(dd::Snapshot(bytes, data.size() - 1U), std::runtime_error);
+  EXPECT_THROW(dd::Snapshot(bytes, dd::SNAPSHOT_HEADER_SIZE - 1U),
+               std::runtime_error);
+  auto corrupted = data;
+  corrupted[0] = 'X';
+  EXPECT_THROW(
+      dd::Snapshot(reinterpret_cast<const std::byte*>(corrupted.data()),
+                   corrupted.size()),
+      std::runtime_error);
+  corrupted = data;
+  corrupted[8] = 2;
+  EXPECT_THROW(
+      dd::Snapshot(reinterpret_cast<const std::byte*>(corrupted.data()),
+                   corrupted.size()),
+      std::runtime_error);
+  EXPECT_THROW(dd->loadSnapshot<dd::vNode>("does_not_exist.ddsnap"),
+               std::invalid_argument);
+  auto small = std::make_unique<dd::Package<>>(1U);
+  EXPECT_THROW(small->importSnapshot<dd::vNode>(snapshot), std::runtime_error);
+}
+
+struct DeepDDPackageConfig : public dd::DDPackageConfig {
+  static constexpr std::size_t UT_VEC_NBUCKET = 1U;
+  static constexpr std::size_t UT_MAT_NBUCKET = 1U;
+};
+
+TEST(DDPackageTest, DeepTraversal) {
+  // the depth of the DDs equals the number of qubits
+  const auto nqubits = 30000U;
+  auto dd = std::make_unique<dd::Package<DeepDDPackageConfig>>(nqubits);
+
+  const auto ghz = dd->makeGHZState(nqubits);
+  dd->incRef(ghz);
+  // two chains of nqubits - 1 nodes, the top node, and the terminal
+  EXPECT_EQ(ghz.size(), 2U * nqubits);
+
+  const auto [pzero, pone] =
+      dd->determineMeasurementProbabilities(ghz, nqubits - 1U, false);
+  EXPECT_NEAR(pzero, 0.5, dd::RealNumber::eps);
+  EXPECT_NEAR(pone, 0.5, dd::RealNumber::eps);
+
+  std::mt19937_64 mt(42U); // NOLINT(cert-msc51-cpp)
+  const auto counts = dd->sampleAll(ghz, 100U, mt);
+  EXPECT_EQ(counts.size(), 2U);
+  EXPECT_EQ(counts.at(std::string(nqubits, '0')) +
+                counts.at(std::string(nqubits, '1')),
+            100U);
+
+  // removing the one-successor of the top node leaves one basis state
+  const auto deleted = dd->deleteEdge(ghz, nqubits - 1U, 1U);
+  EXPECT_EQ(deleted.size(), nqubits + 1U);
+  EXPECT_NEAR(deleted.w.r->value, dd::SQRT2_2, dd::RealNumber::eps);
+
+  const auto ident = dd->makeIdent(nqubits);
+  dd->incRef(ident);
+  EXPECT_EQ(ident.size(), nqubits + 1U);
+  std::stringstream ss{};
+  dd::serialize(ident, ss, true);
+  EXPECT_EQ(dd->deserialize<dd::mNode>(ss, true), ident);
+}
+
+TEST(DDPackageTest, MultiplyByLevel) {
+  const auto nqubits = 6U;
+  const auto dim = 1ULL << nqubits;
+  std::mt19937_64 mt(42U); // NOLINT(cert-msc51-cpp)
+  std::uniform_real_distribution<dd::fp> dist(-1., 1.);
+  dd::CMat matA(dim, dd::CVec(dim));
+  dd::CMat matB(dim, dd::CVec(dim));
+  dd::CVec vec(dim);
+  for (std::size_t i = 0U; i < dim; ++i) {
+    for (std::size_t j = 0U; j < dim; ++j) {
+      matA[i][j] = {dist(mt), dist(mt)};
+      matB[i][j] = {dist(mt), dist(mt)};
+    }
+    vec[i] = {dist(mt), dist(mt)};
+  }
+
+  auto reference = std::make_unique<dd::Package<>>(nqubits);
+  const auto refA = reference->makeDDFromMatrix(matA);
+  const auto refMV =
+      reference->multiply(refA, reference->makeStateFromVector(vec))
+          .getVector();
+  const auto refMM =
+      reference->multiply(refA, reference->makeDDFromMatrix(matB)).getMatrix();
+
+  constexpr auto tol = 1e-8;
+  const auto check = [&](dd::Package<>& dd) {
+    const auto a = dd.makeDDFromMatrix(matA);
+    const auto b = dd.makeDDFromMatrix(matB);
+    const auto v = dd.makeStateFromVector(vec);
+    const auto mv = dd.multiplyByLevel(a, v).getVector();
+    const auto mm = dd.multiplyByLevel(a, b).getMatrix();
+    for (std::size_t i = 0U; i < dim; ++i) {
+      EXPECT_NEAR(std::abs(mv[i] - refMV[i]), 0., tol);
+      for (std::size_t j = 0U; j < dim; ++j) {
+        EXPECT_NEAR(std::abs(mm[i][j] - refMM[i][j]), 0., tol);
+      }
+    }
+
+    // products are reused via the compute table
+    EXPECT_EQ(dd.multiplyByLevel(a, v), dd.multiply(a, v));
+
+    // trivial products
+    EXPECT_EQ(dd.multiplyByLevel(dd.makeIdent(nqubits), v), v);
+    EXPECT_EQ(dd.multiplyByLevel(a, dd.makeIdent(nqubits)), a);
+    EXPECT_EQ(dd.multiplyByLevel(a, dd::vEdge::zero()), dd::vEdge::zero());
+  };
+
+  auto serial = std::make_unique<dd::Package<>>(nqubits);
+  check(*serial);
+
+  auto parallel = std::make_unique<dd::Package<>>(nqubits);
+  parallel->enableParallelEvaluation(4U);
+  check(*parallel);
+}
+
+TEST(DDPackageTest, SnapshotOfFunctionality) {
+  const auto nqubits = 4U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  auto qft = dd->makeIdent(nqubits);
+  dd->incRef(qft);
+  for (auto i = nqubits; i > 0U; --i) {
+    const auto target = static_cast<dd::Qubit>(i - 1U);
+    auto tmp = dd->multiply(dd->makeGateDD(dd::H_MAT, nqubits, target), qft);
+    for (auto j = target; j > 0U; --j) {
+      const auto control = static_cast<dd::Qubit>(j - 1U);
+      const auto phase = dd::PI / static_cast<dd::fp>(1U << (target - control));
+      tmp = dd->multiply(dd->makeGateDD(dd::pMat(phase), nqubits,
+                                        qc::Control{control}, target),
+                         tmp);
+    }
+    dd->incRef(tmp);
+    dd->decRef(qft);
+    qft = tmp;
+  }
+
+  std::stringstream ss{};
+  dd::writeSnapshot(qft, ss);
+  const auto data = ss.str();
+  const dd::Snapshot snapshot(reinterpret_cast<const std::byte*>(data.data()),
+                              data.size());
+  EXPECT_EQ(snapshot.numNodes(), qft.size() - 1U);
+  // nodes are stored in topological order
+  for (std::size_t i = 0U; i < snapshot.numNodes(); ++i) {
+    for (std::size_t j = 0U; j < dd::NEDGE; ++j) {
+      const auto child = snapshot.child(i, j);
+      EXPECT_TRUE(child == dd::Snapshot::NO_NODE || child < i);
+    }
+  }
+  // edges refer to nodes and weights by 32-bit indices
+  EXPECT_LT(data.size() - dd::SNAPSHOT_HEADER_SIZE,
+            snapshot.numNodes() * sizeof(dd::mNode) / 2U);
+
+  // the snapshot can be imported into any package
+  EXPECT_EQ(dd->importSnapshot<dd::mNode>(snapshot), qft);
+  const auto matrix = qft.getMatrix();
+  dd->decRef(qft);
+  dd->garbageCollect(true);
+  auto other = std::make_unique<dd::Package<>>(nqubits);
+  EXPECT_EQ(other->importSnapshot<dd::mNode>(snapshot).getMatrix(), matrix);
+
+  auto small = std::make_unique<dd::Package<>>(1U);
+  EXPECT_THROW(small->importSnapshot<dd::mNode>(snapshot), std::runtime_error);
+}
+
+TEST(DDPackageTest, MemoryBudget) {
+  const auto nqubits = 14U;
+  const auto dim = 1ULL << nqubits;
+  std::mt19937_64 mt(42U); // NOLINT(cert-msc51-cpp)
+  std::uniform_real_distribution<dd::fp> dist(-1., 1.);
+  const auto randomVector = [&]() {
+    dd::CVec vec(dim);
+    for (auto& entry : vec) {
+      entry = {dist(mt), dist(mt)};
+    }
+    return vec;
+  };
+
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  EXPECT_EQ(dd->getMemoryBudget(), 0U);
+  const auto initialUsage = dd->getMemoryUsage();
+  EXPECT_GT(initialUsage, 0U);
+
+  // a dense state requires additional chunks in the memory managers
+  const auto stateSize = dd->makeStateFromVector(randomVector()).size();
+  const auto peakUsage = dd->getMemoryUsage();
+  EXPECT_GT(peakUsage, initialUsage);
+
+  // approaching the budget collects the unreferenced state and releases the
+  // chunks that are no longer used
+  const auto allocated = dd->vMemoryManager.getStats().numAllocated;
+  EXPECT_GT(allocated, stateSize);
+  dd->setMemoryBudget(peakUsage, true);
+  EXPECT_EQ(dd->getMemoryBudget(), peakUsage);
+  EXPECT_TRUE(dd->garbageCollect());
+  EXPECT_EQ(dd->vMemoryManager.getStats().numUsed, 0U);
+  EXPECT_LT(dd->getMemoryUsage(), peakUsage);
+  EXPECT_LT(dd->vMemoryManager.getStats().numAllocated, allocated);
+
+  // operations that do not fit into the budget fail with an exception
+  const auto budget = dd->getMemoryUsage();
+  dd->setMemoryBudget(budget);
+  EXPECT_THROW(static_cast<void>(dd->makeStateFromVector(randomVector())),
+               dd::MemoryBudgetExceeded);
+  EXPECT_LE(dd->getMemoryUsage(), budget);
+
+  // the package remains usable afterwards
+  dd->setMemoryBudget(0U);
+  const auto vec = randomVector();
+  const auto e = dd->makeStateFromVector(vec);
+  const auto result = e.getVector();
+  for (std::size_t i = 0U; i < dim; ++i) {
+    EXPECT_NEAR(std::abs(result[i] - vec[i]), 0., 1e-8);
+  }
+}
+
+TEST(DDPackageTest, MemoryCompaction) {
+  const auto nqubits = 12U;
+  const auto dim = 1ULL << nqubits;
+  std::mt19937_64 mt(42U); // NOLINT(cert-msc51-cpp)
+  std::uniform_real_distribution<dd::fp> dist(-1., 1.);
+  const auto randomVector = [&]() {
+    dd::CVec vec(dim);
+    for (auto& entry : vec) {
+      entry = {dist(mt), dist(mt)};
+    }
+    return vec;
+  };
+
+  const auto check = [&](auto& dd) {
+    const auto vec = randomVector();
+    auto state = dd.makeStateFromVector(vec);
+    dd.incRef(state);
+    auto op = dd.makeGateDD(dd::H_MAT, nqubits, 3U);
+    dd.incRef(op);
+    auto rho = dd.makeZeroDensityOperator(3U);
+    dd.incRef(rho);
+
+    // garbage interleaves free entries with the ones in use
+    for (auto i = 0U; i < 3U; ++i) {
+      static_cast<void>(dd.makeStateFromVector(randomVector()));
+    }
+    dd.garbageCollect(true);
+    const auto& stats = dd.vMemoryManager.getStats();
+    EXPECT_GT(stats.getFragmentation(), 0.);
+    const auto allocated = stats.numAllocated;
+
+    const auto reclaimed = dd.compactMemory(state, op, rho);
+    EXPECT_GT(reclaimed, 0U);
+    EXPECT_EQ(stats.getFragmentation(), 0.);
+    EXPECT_EQ(stats.numAllocated, stats.numUsed);
+    EXPECT_LT(stats.numAllocated, allocated);
+    EXPECT_EQ(stats.numCompactions, 1U);
+    EXPECT_GE(stats.reclaimedBytes, (allocated - stats.numAllocated) *
+                                        sizeof(dd::vNode));
+
+    // the roots still represent the same DDs and remain canonical
+    const auto result = state.getVector();
+    for (std::size_t i = 0U; i < dim; ++i) {
+      EXPECT_NEAR(std::abs(result[i] - vec[i]), 0., 1e-8);
+    }
+    EXPECT_EQ(dd.makeStateFromVector(vec), state);
+    EXPECT_EQ(dd.makeGateDD(dd::H_MAT, nqubits, 3U), op);
+    EXPECT_EQ(dd.makeZeroDensityOperator(3U), rho);
+
+    // the package remains fully functional
+    const auto applied = dd.multiply(op, state);
+    dd.incRef(applied);
+    EXPECT_EQ(dd.multiply(op, applied), state);
+    dd.decRef(applied);
+    dd.decRef(state);
+    dd.decRef(op);
+    dd.decRef(rho);
+    dd.garbageCollect(true);
+    EXPECT_EQ(dd.vMemoryManager.getStats().numUsed, 0U);
+  };
+
+  auto chained = std::make_unique<dd::Package<>>(nqubits);
+  check(*chained);
+  auto open =
+      std::make_unique<dd::Package<OpenAddressingDDPackageConfig>>(nqubits);
+  check(*open);
+}
+
+TEST(DDPackageTest, ApproximateState) {
+  const auto nqubits = 8U;
+  const auto dim = 1ULL << nqubits;
+  std::mt19937_64 mt(42U); // NOLINT(cert-msc51-cpp)
+  std::exponential_distribution<dd::fp> dist(1.);
+  dd::CVec vec(dim);
+  dd::fp norm = 0.;
+  for (auto& entry : vec) {
+    // a few dominant amplitudes and many small ones
+    entry = std::pow(dist(mt), 4.);
+    norm += std::norm(entry);
+  }
+  for (auto& entry : vec) {
+    entry /= std::sqrt(norm);
+  }
+
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  const auto state = dd->makeStateFromVector(vec);
+  EXPECT_EQ(dd->approximate(state, 1.).first, state);
+
+  const auto [approx, fidelity] = dd->approximate(state, 0.95);
+  EXPECT_GE(fidelity, 0.95);
+  EXPECT_LT(fidelity, 1.);
+  EXPECT_LT(approx.size(), state.size());
+  EXPECT_NEAR(dd->fidelity(state, approx), fidelity, 1e-8);
+  // the approximation is renormalized
+  EXPECT_NEAR(dd->innerProduct(approx, approx).r, 1., 1e-8);
+}
+
+TEST(DDPackageTest, IncrementalComputeTableInvalidation) {
+  const auto nqubits = 3U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  const dd::CVec vec{0.1, 0.2, 0.3, 0.4, 0.5, 0.4, 0.3, 0.2};
+  auto state = dd->makeStateFromVector(vec);
+  dd->incRef(state);
+  auto h = dd->makeGateDD(dd::H_MAT, nqubits, 1U);
+  dd->incRef(h);
+  auto live = dd->multiply(h, state);
+  dd->incRef(live);
+
+  // the result of this product (and the gate itself) are not referenced
+  const auto x = dd->makeGateDD(dd::rxMat(0.3), nqubits, 2U);
+  static_cast<void>(dd->multiply(x, state));
+
+  const auto& stats = dd->matrixVectorMultiplication.getStats();
+  const auto entriesBefore = stats.numEntries;
+  const auto lookupsBefore = stats.lookups;
+  EXPECT_TRUE(dd->garbageCollect(true));
+  EXPECT_EQ(stats.gcRuns, 1U);
+  EXPECT_GT(stats.gcInvalidations, 0U);
+  EXPECT_GT(stats.numEntries, 0U);
+  EXPECT_LT(stats.numEntries, entriesBefore);
+  EXPECT_EQ(stats.gcRetentions, stats.numEntries);
+  EXPECT_EQ(stats.lookupsBeforeGC, lookupsBefore);
+
+  // the product of the referenced DDs is still cached
+  const auto hits = stats.hits;
+  EXPECT_EQ(dd->multiply(h, state), live);
+  EXPECT_GT(stats.hits, hits);
+  EXPECT_EQ(stats.hitRatioAfterGC(), 1.);
+  const auto json = stats.json();
+  EXPECT_EQ(json["gc_runs"], 1U);
+  EXPECT_TRUE(json.contains("hit_ratio_before_gc"));
+
+  const auto summary = dd::getStatistics(dd.get())["compute_table_gc"];
+  EXPECT_GE(summary["invalidations"], stats.gcInvalidations);
+  EXPECT_EQ(summary["hit_ratio_after_gc"], 1.);
+}
+
+TEST(DDPackageTest, TransferMatrix) {
+  const auto nqubits = 3U;
+  auto source = std::make_unique<dd::Package<>>(nqubits);
+  auto target = std::make_unique<dd::Package<>>(nqubits);
+
+  // a matrix with shared successors and zero blocks
+  auto m = source->makeGateDD(dd::H_MAT, nqubits, 0U);
+  m = source->multiply(
+      source->makeGateDD(dd::X_MAT, nqubits, qc::Control{0U}, 2U), m);
+  m = source->multiply(source->makeGateDD(dd::rzMat(0.3), nqubits, 1U), m);
+  source->incRef(m);
+
+  const auto transferred = target->transfer(m);
+  EXPECT_EQ(transferred.size(), m.size());
+  const auto expected = m.getMatrix();
+  const auto actual = transferred.getMatrix();
+  for (std::size_t i = 0U; i < expected.size(); ++i) {
+    for (std::size_t j = 0U; j < expected.size(); ++j) {
+      EXPECT_NEAR(std::abs(actual[i][j] - expected[i][j]), 0., 1e-10);
+    }
+  }
+  source->decRef(m);
+}
+
+TEST(DDPackageTest, MultiplyExtendedGate) {
+  const auto nqubits = 5U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  dd::CVec vec(1ULL << nqubits);
+  for (std::size_t i = 0U; i < vec.size(); ++i) {
+    vec[i] = {static_cast<dd::fp>(i % 7U), static_cast<dd::fp>(i % 3U)};
+  }
+  auto state = dd->makeStateFromVector(vec);
+  dd->incRef(state);
+  auto matrix = dd->multiply(dd->makeGateDD(dd::H_MAT, nqubits, 4U),
+                             dd->makeGateDD(dd::rxMat(0.3), nqubits, 1U));
+  dd->incRef(matrix);
+
+  // the gates only span the qubits up to the highest one they act on
+  const auto local = dd->makeGateDD(dd::X_MAT, 3U, qc::Control{0U}, 2U);
+  const auto full = dd->makeGateDD(dd::X_MAT, nqubits, qc::Control{0U}, 2U);
+  EXPECT_EQ(local.p->v, 2U);
+  EXPECT_EQ(dd->multiplyExtended(local, state), dd->multiply(full, state));
+  EXPECT_EQ(dd->multiplyExtended(local, matrix), dd->multiply(full, matrix));
+
+  const auto localTwo = dd->makeTwoQubitGateDD(dd::rzzMat(0.7), 4U, 1U, 3U);
+  const auto fullTwo =
+      dd->makeTwoQubitGateDD(dd::rzzMat(0.7), nqubits, 1U, 3U);
+  EXPECT_EQ(dd->multiplyExtended(localTwo, state),
+            dd->multiply(fullTwo, state));
+  EXPECT_EQ(dd->multiplyExtended(localTwo, matrix),
+            dd->multiply(fullTwo, matrix));
+
+  // gates of full width are multiplied as usual
+  EXPECT_EQ(dd->multiplyExtended(full, state), dd->multiply(full, state));
+
+  // the lines below a gate are served from the identity table
+  const auto high = dd->makeGateDD(dd::Z_MAT, nqubits, qc::Control{3U}, 4U);
+  EXPECT_EQ(high.p->e[0].p->e[0].p, dd->makeIdent(3U).p);
+  EXPECT_EQ(high.p->e[3].p->e[3].p, dd->makeIdent(3U).p);
+
+  // the gate must not be wider than the DD it is applied to
+  const auto narrow = dd->makeZeroState(2U);
+  EXPECT_THROW(static_cast<void>(dd->multiplyExtended(local, narrow)),
+               std::invalid_argument);
+
+  dd->decRef(matrix);
+  dd->decRef(state);
+}
+
+TEST(DDPackageTest, MemoryBudgetParallel) {
+  const auto nqubits = 12U;
+  const auto dim = 1ULL << nqubits;
+  std::mt19937_64 mt(42U); // NOLINT(cert-msc51-cpp)
+  std::uniform_real_distribution<dd::fp> dist(-1., 1.);
+  const auto randomVector = [&]() {
+    dd::CVec vec(dim);
+    for (auto& entry : vec) {
+      entry = {dist(mt), dist(mt)};
+    }
+    return vec;
+  };
+
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  const auto x = dd->makeStateFromVector(randomVector());
+  dd->incRef(x);
+  const auto y = dd->makeStateFromVector(randomVector());
+  dd->incRef(y);
+  const auto h = dd->makeGateDD(dd::H_MAT, nqubits, nqubits - 1U);
+  dd->incRef(h);
+  dd->garbageCollect(true);
+
+  // allocations of the worker threads are checked against the budget and all
+  // tasks finish before the exception is propagated
+  dd->enableParallelEvaluation(4U, 4U);
+  const auto budget = dd->getMemoryUsage();
+  dd->setMemoryBudget(budget);
+  EXPECT_THROW(static_cast<void>(dd->add(x, y)), dd::MemoryBudgetExceeded);
+  EXPECT_LE(dd->getMemoryUsage(), budget);
+  EXPECT_THROW(static_cast<void>(dd->multiply(h, x)),
+               dd::MemoryBudgetExceeded);
+  EXPECT_LE(dd->getMemoryUsage(), budget);
+
+  // the package remains usable afterwards
+  dd->setMemoryBudget(0U);
+  dd->garbageCollect(true);
+  const auto sum = dd->add(x, y);
+  const auto xVec = x.getVector();
+  const auto yVec = y.getVector();
+  const auto result = sum.getVector();
+  for (std::size_t i = 0U; i < dim; ++i) {
+    EXPECT_NEAR(std::abs(result[i] - (xVec[i] + yVec[i])), 0., 1e-8);
+  }
+  dd->decRef(h);
+  dd->decRef(y);
+  dd->decRef(x);
+}